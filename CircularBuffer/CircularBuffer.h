@@ -0,0 +1,374 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// 용량 결정 방식
+enum class CapacityPolicy {
+    Exact,      // 요청한 용량 그대로 사용
+    PowerOfTwo  // 2의 거듭제곱으로 올림 -> 인덱스 계산이 % 대신 비트 마스크
+};
+
+// CircularBuffer<T, N>의 N 기본값: 용량을 생성자에서 런타임에 결정
+inline constexpr std::size_t dynamic_capacity = static_cast<std::size_t>(-1);
+
+// 원형 버퍼 계열(CircularBuffer / SpscCircularBuffer 등)이 공유하는 상수/유틸
+namespace circular_buffer_detail {
+    // false sharing 방지를 위해 인덱스를 분리할 캐시 라인 크기
+    inline constexpr std::size_t cache_line_size = 64;
+
+    inline bool is_pow2(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+    // n 이상인 가장 작은 2의 거듭제곱 (0이면 1). 표현할 수 없을 만큼 크면 std::length_error
+    inline std::size_t round_up_pow2(std::size_t n) {
+        constexpr std::size_t largest = std::size_t(1) << (sizeof(std::size_t) * 8 - 1);
+        if (n > largest) throw std::length_error("2의 거듭제곱으로 올릴 수 없는 용량입니다");
+        return std::bit_ceil(n);
+    }
+
+    // 단조 증가 카운터 -> 실제 슬롯 번호 변환
+    // 용량이 2의 거듭제곱이면(정책과 무관하게) 비트 마스크, 아니면 % 사용
+    class SlotIndexer {
+    private:
+        std::size_t m_capacity;
+        std::size_t m_mask;
+        bool m_pow2;
+
+    public:
+        SlotIndexer(std::size_t capacity, CapacityPolicy policy)
+            : m_capacity(policy == CapacityPolicy::PowerOfTwo ? round_up_pow2(capacity) : capacity),
+              m_mask(m_capacity - 1),
+              m_pow2(is_pow2(m_capacity)) {}
+
+        std::size_t capacity() const { return m_capacity; }
+        std::size_t operator()(std::size_t i) const { return m_pow2 ? (i & m_mask) : (i % m_capacity); }
+    };
+
+    // 런타임 용량: allocator로 확보한 초기화되지 않은 메모리 + SlotIndexer
+    // 원소는 construct()로 생성하고 destroy()로 소멸 (살아 있는 범위는 CircularBuffer가 관리)
+    template <typename T, typename Allocator>
+    class DynamicStorage {
+    public:
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    private:
+        using traits = std::allocator_traits<allocator_type>;
+
+        [[no_unique_address]] allocator_type alloc;
+        SlotIndexer index;
+        T* buffer;
+
+    public:
+        DynamicStorage(std::size_t capacity, CapacityPolicy policy, const allocator_type& a)
+            : alloc(a), index(capacity, policy), buffer(traits::allocate(alloc, index.capacity())) {}
+        ~DynamicStorage() { traits::deallocate(alloc, buffer, index.capacity()); }
+
+        DynamicStorage(const DynamicStorage&) = delete;
+        DynamicStorage& operator=(const DynamicStorage&) = delete;
+
+        allocator_type get_allocator() const { return alloc; }
+        std::size_t capacity() const { return index.capacity(); }
+        std::size_t slot(std::size_t i) const { return index(i); }
+        T* data() { return buffer; }
+        const T* data() const { return buffer; }
+
+        template <typename... Args>
+        void construct(std::size_t s, Args&&... args) {
+            traits::construct(alloc, buffer + s, std::forward<Args>(args)...);
+        }
+        void destroy(std::size_t s) { traits::destroy(alloc, buffer + s); }
+    };
+
+    // 컴파일 타임 용량: 객체 안에 직접 배치 (힙 할당/포인터 역참조 없음, constexpr 사용 가능)
+    // constexpr 문맥을 위해 슬롯은 항상 초기화된 상태로 두고, 생성/소멸은 대입으로 처리
+    template <typename T, std::size_t N>
+    class InlineStorage {
+        static_assert(N > 0, "CircularBuffer<T, N>의 N은 1 이상이어야 합니다");
+
+    private:
+        T buffer[N]{};
+
+    public:
+        constexpr InlineStorage() = default;
+
+        static constexpr std::size_t capacity() { return N; }
+        static constexpr std::size_t slot(std::size_t i) {
+            if constexpr ((N & (N - 1)) == 0) return i & (N - 1);
+            else return i % N;
+        }
+        constexpr T* data() { return buffer; }
+        constexpr const T* data() const { return buffer; }
+
+        template <typename... Args>
+        constexpr void construct(std::size_t s, Args&&... args) {
+            buffer[s] = T(std::forward<Args>(args)...);
+        }
+        // 소멸 대신 빈 값으로 되돌려 보유 중인 자원(문자열 버퍼 등)을 즉시 해제
+        constexpr void destroy(std::size_t s) {
+            if constexpr (!std::is_trivially_destructible_v<T>) buffer[s] = T();
+        }
+    };
+}
+
+// N == dynamic_capacity(기본값): 생성자에서 용량 지정, Allocator로 확보한 메모리에 저장
+// N 지정(CircularBuffer<T, 5> 등): 객체 안에 인라인 저장, 인덱스 계산이 상수로 접힘 (Allocator 미사용)
+template <typename T, size_t N = dynamic_capacity, typename Allocator = std::allocator<T>>
+class CircularBuffer {
+private:
+    using storage_type = std::conditional_t<N == dynamic_capacity,
+                                            circular_buffer_detail::DynamicStorage<T, Allocator>,
+                                            circular_buffer_detail::InlineStorage<T, N>>;
+
+    storage_type storage;
+    // head/tail은 단조 증가 카운터 (실제 슬롯은 storage.slot()으로 변환)
+    size_t head = 0;   // 가장 오래된 데이터의 위치 (지금까지 pop된 개수)
+    size_t tail = 0;   // 다음에 추가될 위치 (지금까지 push된 개수)
+
+    constexpr T& at_pos(size_t pos) { return storage.data()[storage.slot(pos)]; }
+    constexpr const T& at_pos(size_t pos) const { return storage.data()[storage.slot(pos)]; }
+
+    // 슬롯 s부터 연속된 n칸을 src로 채움 (해당 슬롯들은 비어 있어야 함)
+    constexpr void copy_into(size_t s, const T* src, size_t n) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::copy_n(src, n, storage.data() + s);  // trivially copyable이면 memmove로 최적화됨
+        } else {
+            for (size_t i = 0; i < n; ++i) storage.construct(s + i, src[i]);
+        }
+    }
+
+    template <typename U, typename P>
+    constexpr std::array<std::span<U>, 2> make_segments(P data) const {
+        const size_t h = storage.slot(head);
+        const size_t first_len = std::min(size(), capacity() - h);
+        return {std::span<U>(data + h, first_len), std::span<U>(data, size() - first_len)};
+    }
+
+public:
+    template <size_t M = N, std::enable_if_t<M == dynamic_capacity, int> = 0>
+    CircularBuffer(size_t capacity, CapacityPolicy policy = CapacityPolicy::Exact,
+                   const Allocator& alloc = Allocator())
+        : storage(capacity, policy, alloc) {}
+
+    template <size_t M = N, std::enable_if_t<M == dynamic_capacity, int> = 0>
+    CircularBuffer(size_t capacity, const Allocator& alloc)
+        : storage(capacity, CapacityPolicy::Exact, alloc) {}
+
+    template <size_t M = N, std::enable_if_t<M != dynamic_capacity, int> = 0>
+    constexpr CircularBuffer() {}
+
+    CircularBuffer(const CircularBuffer&) = delete;
+    CircularBuffer& operator=(const CircularBuffer&) = delete;
+
+    constexpr ~CircularBuffer() { clear(); }
+
+    constexpr size_t size() const { return tail - head; }
+    constexpr size_t capacity() const { return storage.capacity(); }
+    constexpr bool empty() const { return head == tail; }
+
+    template <size_t M = N, std::enable_if_t<M == dynamic_capacity, int> = 0>
+    auto get_allocator() const { return storage.get_allocator(); }
+
+    constexpr void pop_front() {
+        if (empty()) return;
+        storage.destroy(storage.slot(head));
+        head++;
+    }
+
+    // 가장 최근 데이터 하나를 버림 (monotonic deque 등 양방향 사용)
+    constexpr void pop_back() {
+        if (empty()) return;
+        tail--;
+        storage.destroy(storage.slot(tail));
+    }
+
+    constexpr void clear() {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            head = tail;
+        } else {
+            while (!empty()) pop_front();
+        }
+    }
+
+    // 빈 슬롯에 바로 생성. 가득 차면 가장 오래된 데이터를 소멸시키고 그 자리에 생성
+    template <typename... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        const size_t s = storage.slot(tail);
+        if (size() == capacity()) {
+            // 인자가 버퍼 안의 원소(front() 등)를 가리킬 수 있으므로 먼저 값을 만든 뒤 교체
+            T value(std::forward<Args>(args)...);
+            storage.destroy(s);
+            head++;
+            storage.construct(s, std::move(value));
+        } else {
+            storage.construct(s, std::forward<Args>(args)...);
+        }
+        tail++;
+        return back();
+    }
+
+    constexpr void push_back(const T& item) { emplace_back(item); }
+    constexpr void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    // n개를 한 번에 추가. 넘치는 만큼 오래된 데이터를 버리며, n >= capacity면 마지막 capacity개만 남음
+    // (first는 이 버퍼 내부를 가리키면 안 됨)
+    constexpr void push_back(const T* first, size_t n) {
+        if (n >= capacity()) {
+            clear();
+            first += n - capacity();
+            n = capacity();
+        } else if (size() + n > capacity()) {
+            pop_front(size() + n - capacity());
+        }
+
+        // 래핑 지점 기준으로 최대 두 구간에 나눠 복사
+        const size_t s = storage.slot(tail);
+        const size_t first_len = std::min(n, capacity() - s);
+        copy_into(s, first, first_len);
+        copy_into(0, first + first_len, n - first_len);
+        tail += n;
+    }
+
+    // 오래된 데이터 n개를 한 번에 버림 (n > size()면 전부)
+    constexpr void pop_front(size_t n) {
+        n = std::min(n, size());
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            head += n;
+        } else {
+            for (size_t i = 0; i < n; ++i) pop_front();
+        }
+    }
+
+    // 현재 내용을 오래된 순서로 최대 두 개의 연속 구간으로 반환 (래핑 전 / 래핑 후)
+    // 래핑되지 않았으면 두 번째 구간은 비어 있음. memcpy, write(), SIMD 등에 그대로 전달 가능
+    constexpr std::array<std::span<T>, 2> segments() { return make_segments<T>(storage.data()); }
+    constexpr std::array<std::span<const T>, 2> segments() const {
+        return make_segments<const T>(storage.data());
+    }
+
+    constexpr T& front() { return at_pos(head); }
+    constexpr const T& front() const { return at_pos(head); }
+
+    constexpr T& back() { return at_pos(tail - 1); }
+    constexpr const T& back() const { return at_pos(tail - 1); }
+
+    // 논리 순서(가장 오래된 데이터 = 0) 기준 random access iterator
+    // IsConst == true면 const_iterator
+    template <bool IsConst>
+    class BasicIterator {
+    private:
+        using buffer_pointer = std::conditional_t<IsConst, const CircularBuffer*, CircularBuffer*>;
+
+        buffer_pointer ptr = nullptr;
+        std::ptrdiff_t offset = 0;
+
+        friend class CircularBuffer;
+        friend class BasicIterator<!IsConst>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        constexpr BasicIterator() = default;
+        constexpr BasicIterator(buffer_pointer p, std::ptrdiff_t o) : ptr(p), offset(o) {}
+
+        // iterator -> const_iterator 변환
+        template <bool C = IsConst, std::enable_if_t<C, int> = 0>
+        constexpr BasicIterator(const BasicIterator<false>& other) : ptr(other.ptr), offset(other.offset) {}
+
+        constexpr reference operator*() const { return ptr->at_pos(ptr->head + offset); }
+        constexpr pointer operator->() const { return &**this; }
+        constexpr reference operator[](difference_type n) const { return ptr->at_pos(ptr->head + (offset + n)); }
+
+        constexpr BasicIterator& operator++() { offset++; return *this; }
+        constexpr BasicIterator operator++(int) { BasicIterator tmp = *this; offset++; return tmp; }
+        constexpr BasicIterator& operator--() { offset--; return *this; }
+        constexpr BasicIterator operator--(int) { BasicIterator tmp = *this; offset--; return tmp; }
+
+        constexpr BasicIterator& operator+=(difference_type n) { offset += n; return *this; }
+        constexpr BasicIterator& operator-=(difference_type n) { offset -= n; return *this; }
+
+        friend constexpr BasicIterator operator+(BasicIterator it, difference_type n) { return it += n; }
+        friend constexpr BasicIterator operator+(difference_type n, BasicIterator it) { return it += n; }
+        friend constexpr BasicIterator operator-(BasicIterator it, difference_type n) { return it -= n; }
+        friend constexpr difference_type operator-(const BasicIterator& a, const BasicIterator& b) {
+            return a.offset - b.offset;
+        }
+
+        constexpr bool operator==(const BasicIterator& other) const {
+            return ptr == other.ptr && offset == other.offset;
+        }
+        // 같은 버퍼의 iterator끼리만 비교 (논리 위치 기준)
+        constexpr auto operator<=>(const BasicIterator& other) const { return offset <=> other.offset; }
+    };
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using Iterator = iterator;  // 기존 이름 호환
+
+    // 논리 순서 기준 접근 (0 = 가장 오래된 데이터)
+    constexpr T& operator[](size_t i) { return at_pos(head + i); }
+    constexpr const T& operator[](size_t i) const { return at_pos(head + i); }
+
+    constexpr iterator begin() { return iterator(this, 0); }
+    constexpr iterator end() { return iterator(this, (std::ptrdiff_t)size()); }
+    constexpr const_iterator begin() const { return const_iterator(this, 0); }
+    constexpr const_iterator end() const { return const_iterator(this, (std::ptrdiff_t)size()); }
+    constexpr const_iterator cbegin() const { return begin(); }
+    constexpr const_iterator cend() const { return end(); }
+
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crbegin() const { return rbegin(); }
+    constexpr const_reverse_iterator crend() const { return rend(); }
+
+    // 추가: 영상용 상태 출력(논리 순서 + raw 배열 + head/tail 표시)
+    void debug_print(const std::string& label = "") const {
+        const size_t head_slot = storage.slot(head);
+        const size_t tail_slot = empty() ? capacity() : storage.slot(tail - 1);  // 비어 있으면 표시 안 함
+
+        if (!label.empty()) std::cout << "\n==== " << label << " ====\n";
+        std::cout << "size=" << size() << "/" << capacity() << ", head=" << head_slot << ", tail=";
+        if (empty()) std::cout << "-";
+        else std::cout << tail_slot;
+        std::cout << "\n";
+
+        std::cout << "logical order: ";
+        for (size_t i = 0; i < size(); ++i) {
+            std::cout << at_pos(head + i) << " ";
+        }
+        std::cout << "\nraw slots:     ";
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (i == head_slot) std::cout << "H";
+            if (i == tail_slot) std::cout << "T";
+            std::cout << "[" << i << "]=";
+            // 살아 있는 원소만 출력 (빈 슬롯은 생성되지 않은 메모리일 수 있음)
+            if ((i + capacity() - head_slot) % capacity() < size()) std::cout << storage.data()[i];
+            else std::cout << "-";
+            std::cout << " ";
+        }
+        std::cout << "\n";
+    }
+};
@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CircularBuffer.h"
+#include "CircularBufferSimd.h"
+#include "MpmcCircularBuffer.h"
+#include "SpscCircularBuffer.h"
+
+// CircularBuffer 성능 측정용 벤치마크
+// - push/pop 처리량, 순회, 집계를 원소 타입 / 용량별로 측정
+// - 비교 대상: std::deque, std::vector(앞 원소 erase 방식), 멀티 스레드는 mutex + std::deque
+// - 결과는 JSON(기본) 또는 CSV로 stdout에 출력 -> 릴리스 간 비교용
+//
+// 사용법: CircularBufferBenchmark [--format=json|csv] [--quick]
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+// 컴파일러가 측정 대상 연산을 제거하지 못하게 함
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Result {
+    std::string benchmark;  // push_pop / iterate / aggregate / spsc / mpmc
+    std::string container;
+    std::string type;
+    size_t capacity;
+    size_t threads;
+    std::uint64_t ops;
+    double seconds;
+
+    double ns_per_op() const { return seconds * 1e9 / (double)ops; }
+    double mops() const { return (double)ops / seconds / 1e6; }
+};
+
+std::vector<Result> results;
+
+template <typename F>
+double time_seconds(F&& f) {
+    const auto start = bench_clock::now();
+    f();
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+// 측정용 원소 타입
+struct Payload64 {
+    std::uint64_t words[8];
+    bool operator<(const Payload64& o) const { return words[0] < o.words[0]; }
+};
+
+template <typename T> const char* type_name();
+template <> const char* type_name<std::int32_t>() { return "int32"; }
+template <> const char* type_name<float>() { return "float"; }
+template <> const char* type_name<double>() { return "double"; }
+template <> const char* type_name<Payload64>() { return "payload64"; }
+
+template <typename T>
+T make_value(std::uint64_t i) {
+    if constexpr (std::is_same_v<T, Payload64>) {
+        Payload64 p{};
+        p.words[0] = i;
+        return p;
+    } else {
+        return (T)(i & 0xffff);
+    }
+}
+
+// 가득 찬 뒤 덮어쓰기 방식(CircularBuffer::push_back 의미)을 세 컨테이너에 똑같이 적용
+template <typename T>
+struct DequeRing {
+    std::deque<T> d;
+    size_t cap;
+    explicit DequeRing(size_t capacity) : cap(capacity) {}
+    void push_back(const T& x) {
+        if (d.size() == cap) d.pop_front();
+        d.push_back(x);
+    }
+    void pop_front() { d.pop_front(); }
+    bool empty() const { return d.empty(); }
+    auto begin() const { return d.begin(); }
+    auto end() const { return d.end(); }
+};
+
+template <typename T>
+struct VectorRing {
+    std::vector<T> v;
+    size_t cap;
+    explicit VectorRing(size_t capacity) : cap(capacity) { v.reserve(capacity); }
+    void push_back(const T& x) {
+        if (v.size() == cap) v.erase(v.begin());  // 모든 원소를 한 칸씩 당김 (O(n))
+        v.push_back(x);
+    }
+    void pop_front() { v.erase(v.begin()); }
+    bool empty() const { return v.empty(); }
+    auto begin() const { return v.begin(); }
+    auto end() const { return v.end(); }
+};
+
+template <typename T>
+struct RingAdapter {
+    CircularBuffer<T> b;
+    explicit RingAdapter(size_t capacity) : b(capacity) {}
+    void push_back(const T& x) { b.push_back(x); }
+    void pop_front() { b.pop_front(); }
+    bool empty() const { return b.empty(); }
+    auto begin() const { return b.begin(); }
+    auto end() const { return b.end(); }
+};
+
+// 큰 용량에서 O(n) 컨테이너는 같은 연산 수로 돌리면 너무 오래 걸리므로 연산 수를 줄임
+std::uint64_t scaled_ops(std::uint64_t ops, size_t capacity, bool linear) {
+    if (!linear) return ops;
+    return std::max<std::uint64_t>(1000, std::min<std::uint64_t>(ops, ops * 64 / capacity));
+}
+
+// capacity개로 채우되 원형 버퍼는 내용이 래핑 지점을 걸치도록 함
+// (push 직후 pop을 반복해 위치만 옮기므로 vector도 O(1)씩)
+template <typename T, typename Ring>
+void fill_wrapped(Ring& ring, size_t capacity) {
+    for (size_t i = 0; i < capacity / 3; ++i) {
+        ring.push_back(make_value<T>(i));
+        ring.pop_front();
+    }
+    for (size_t i = 0; i < capacity; ++i) ring.push_back(make_value<T>(i));
+}
+
+// 가득 찬 상태에서 push(덮어쓰기) + 주기적 pop
+template <typename T, typename Ring>
+void bench_push_pop(const char* container, size_t capacity, std::uint64_t ops) {
+    Ring ring(capacity);
+    for (size_t i = 0; i < capacity; ++i) ring.push_back(make_value<T>(i));
+    const double s = time_seconds([&] {
+        for (std::uint64_t i = 0; i < ops; ++i) {
+            ring.push_back(make_value<T>(i));
+            if ((i & 7) == 7) ring.pop_front();
+        }
+    });
+    do_not_optimize(ring);
+    results.push_back({"push_pop", container, type_name<T>(), capacity, 1, ops, s});
+}
+
+// 가득 찬 버퍼를 반복자로 처음부터 끝까지 순회 (passes번)
+template <typename T, typename Ring>
+void bench_iterate(const char* container, size_t capacity, std::uint64_t elements) {
+    Ring ring(capacity);
+    fill_wrapped<T>(ring, capacity);
+    const std::uint64_t passes = std::max<std::uint64_t>(1, elements / capacity);
+    std::uint64_t acc = 0;
+    const double s = time_seconds([&] {
+        for (std::uint64_t p = 0; p < passes; ++p) {
+            for (const T& x : ring) {
+                if constexpr (std::is_same_v<T, Payload64>) acc += x.words[0];
+                else acc += (std::uint64_t)x;
+            }
+            do_not_optimize(acc);
+        }
+    });
+    results.push_back({"iterate", container, type_name<T>(), capacity, 1, passes * capacity, s});
+}
+
+// 합계 집계: 반복자 + std::accumulate vs segments() + SIMD 커널
+template <typename T>
+void bench_aggregate(size_t capacity, std::uint64_t elements) {
+    RingAdapter<T> ring(capacity);
+    fill_wrapped<T>(ring, capacity);
+    const CircularBuffer<T>& b = ring.b;
+    const std::uint64_t passes = std::max<std::uint64_t>(1, elements / capacity);
+
+    double s = time_seconds([&] {
+        for (std::uint64_t p = 0; p < passes; ++p) {
+            auto r = std::accumulate(b.begin(), b.end(), circular_buffer_simd::accum_type<T>(0));
+            do_not_optimize(r);
+        }
+    });
+    results.push_back({"aggregate", "CircularBuffer+accumulate", type_name<T>(), capacity, 1, passes * capacity, s});
+
+    s = time_seconds([&] {
+        for (std::uint64_t p = 0; p < passes; ++p) {
+            auto r = circular_buffer_simd::sum(b);
+            do_not_optimize(r);
+        }
+    });
+    const std::string name = std::string("CircularBuffer+simd(") + circular_buffer_simd::active_isa<T>() + ")";
+    results.push_back({"aggregate", name, type_name<T>(), capacity, 1, passes * capacity, s});
+
+    DequeRing<T> d(capacity);
+    fill_wrapped<T>(d, capacity);
+    s = time_seconds([&] {
+        for (std::uint64_t p = 0; p < passes; ++p) {
+            auto r = std::accumulate(d.begin(), d.end(), circular_buffer_simd::accum_type<T>(0));
+            do_not_optimize(r);
+        }
+    });
+    results.push_back({"aggregate", "std::deque+accumulate", type_name<T>(), capacity, 1, passes * capacity, s});
+}
+
+// 생산자 1 / 소비자 1: SpscCircularBuffer vs mutex + std::deque
+template <typename T>
+void bench_spsc(size_t capacity, std::uint64_t ops) {
+    {
+        SpscCircularBuffer<T> q(capacity);
+        const double s = time_seconds([&] {
+            std::thread producer([&] {
+                for (std::uint64_t i = 0; i < ops;) {
+                    if (q.try_push(make_value<T>(i))) ++i;
+                    else std::this_thread::yield();
+                }
+            });
+            T out{};
+            for (std::uint64_t i = 0; i < ops;) {
+                if (q.try_pop(out)) ++i;
+                else std::this_thread::yield();
+            }
+            do_not_optimize(out);
+            producer.join();
+        });
+        results.push_back({"spsc", "SpscCircularBuffer", type_name<T>(), capacity, 2, ops, s});
+    }
+    {
+        std::mutex m;
+        std::deque<T> d;
+        const double s = time_seconds([&] {
+            std::thread producer([&] {
+                for (std::uint64_t i = 0; i < ops;) {
+                    {
+                        std::lock_guard<std::mutex> lock(m);
+                        if (d.size() < capacity) {
+                            d.push_back(make_value<T>(i));
+                            ++i;
+                            continue;
+                        }
+                    }
+                    std::this_thread::yield();
+                }
+            });
+            T out{};
+            for (std::uint64_t i = 0; i < ops;) {
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!d.empty()) {
+                        out = d.front();
+                        d.pop_front();
+                        ++i;
+                        continue;
+                    }
+                }
+                std::this_thread::yield();
+            }
+            do_not_optimize(out);
+            producer.join();
+        });
+        results.push_back({"spsc", "mutex+std::deque", type_name<T>(), capacity, 2, ops, s});
+    }
+}
+
+// 생산자 n / 소비자 n: MpmcCircularBuffer vs mutex + std::deque
+template <typename T>
+void bench_mpmc(size_t capacity, size_t pairs, std::uint64_t ops) {
+    const std::uint64_t per_thread = ops / pairs;
+    auto run = [&](auto&& push, auto&& pop) {
+        return time_seconds([&] {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < pairs; ++t) {
+                threads.emplace_back([&] {
+                    for (std::uint64_t i = 0; i < per_thread;) {
+                        if (push(make_value<T>(i))) ++i;
+                        else std::this_thread::yield();
+                    }
+                });
+                threads.emplace_back([&] {
+                    T out{};
+                    for (std::uint64_t i = 0; i < per_thread;) {
+                        if (pop(out)) ++i;
+                        else std::this_thread::yield();
+                    }
+                    do_not_optimize(out);
+                });
+            }
+            for (auto& t : threads) t.join();
+        });
+    };
+
+    MpmcCircularBuffer<T> q(capacity);
+    double s = run([&](const T& x) { return q.try_push(x); }, [&](T& out) { return q.try_pop(out); });
+    results.push_back({"mpmc", "MpmcCircularBuffer", type_name<T>(), capacity, 2 * pairs, per_thread * pairs, s});
+
+    std::mutex m;
+    std::deque<T> d;
+    s = run(
+        [&](const T& x) {
+            std::lock_guard<std::mutex> lock(m);
+            if (d.size() >= capacity) return false;
+            d.push_back(x);
+            return true;
+        },
+        [&](T& out) {
+            std::lock_guard<std::mutex> lock(m);
+            if (d.empty()) return false;
+            out = d.front();
+            d.pop_front();
+            return true;
+        });
+    results.push_back({"mpmc", "mutex+std::deque", type_name<T>(), capacity, 2 * pairs, per_thread * pairs, s});
+}
+
+template <typename T>
+void bench_type(const std::vector<size_t>& capacities, std::uint64_t ops) {
+    for (size_t capacity : capacities) {
+        bench_push_pop<T, RingAdapter<T>>("CircularBuffer", capacity, ops);
+        bench_push_pop<T, DequeRing<T>>("std::deque", capacity, ops);
+        bench_push_pop<T, VectorRing<T>>("std::vector(erase)", capacity, scaled_ops(ops, capacity, true));
+
+        bench_iterate<T, RingAdapter<T>>("CircularBuffer", capacity, ops);
+        bench_iterate<T, DequeRing<T>>("std::deque", capacity, ops);
+        bench_iterate<T, VectorRing<T>>("std::vector(erase)", capacity, ops);
+    }
+}
+
+void print_json() {
+    std::printf("{\n  \"benchmark\": \"CircularBuffer\",\n  \"hardware_threads\": %u,\n  \"results\": [\n",
+                std::thread::hardware_concurrency());
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::printf("    {\"benchmark\": \"%s\", \"container\": \"%s\", \"type\": \"%s\", \"capacity\": %zu, "
+                    "\"threads\": %zu, \"ops\": %llu, \"seconds\": %.6f, \"ns_per_op\": %.3f, \"mops\": %.3f}%s\n",
+                    r.benchmark.c_str(), r.container.c_str(), r.type.c_str(), r.capacity, r.threads,
+                    (unsigned long long)r.ops, r.seconds, r.ns_per_op(), r.mops(),
+                    i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+void print_csv() {
+    std::printf("benchmark,container,type,capacity,threads,ops,seconds,ns_per_op,mops\n");
+    for (const Result& r : results) {
+        std::printf("%s,%s,%s,%zu,%zu,%llu,%.6f,%.3f,%.3f\n", r.benchmark.c_str(), r.container.c_str(),
+                    r.type.c_str(), r.capacity, r.threads, (unsigned long long)r.ops, r.seconds, r.ns_per_op(),
+                    r.mops());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    bool quick = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--format=csv") == 0) csv = true;
+        else if (std::strcmp(argv[i], "--format=json") == 0) csv = false;
+        else if (std::strcmp(argv[i], "--quick") == 0) quick = true;
+        else {
+            std::cerr << "사용법: " << argv[0] << " [--format=json|csv] [--quick]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::uint64_t ops = quick ? 200000 : 5000000;
+    const std::vector<size_t> capacities = quick ? std::vector<size_t>{64, 4096}
+                                                 : std::vector<size_t>{64, 4096, 1 << 20};
+
+    bench_type<std::int32_t>(capacities, ops);
+    bench_type<double>(capacities, ops);
+    bench_type<Payload64>(capacities, ops);
+
+    for (size_t capacity : capacities) {
+        bench_aggregate<float>(capacity, ops * 4);
+        bench_aggregate<double>(capacity, ops * 4);
+        bench_aggregate<std::int32_t>(capacity, ops * 4);
+    }
+
+    const size_t pairs = std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+    for (size_t capacity : {size_t(1024), size_t(65536)}) {
+        bench_spsc<std::int32_t>(capacity, ops);
+        bench_spsc<Payload64>(capacity, ops);
+        bench_mpmc<std::int32_t>(capacity, pairs, ops);
+    }
+
+    if (csv) print_csv();
+    else print_json();
+    return 0;
+}
@@ -0,0 +1,588 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "CircularBuffer.h"
+
+// CircularBuffer 전체를 훑는 집계(sum/min/max/dot/threshold count)용 SIMD 커널
+// - segments()의 두 연속 구간에 대해 각각 커널을 실행한 뒤 결과를 합침
+// - x86: 실행 시점에 AVX2 지원 여부를 확인해 AVX2 / 스칼라 중 선택 (첫 호출 시 1회)
+// - AArch64: NEON이 기본 사양이므로 항상 NEON
+// - SIMD 경로는 float / double / int32_t, 그 밖의 산술 타입은 스칼라
+// 부동소수점 합계는 덧셈 순서가 달라지므로 std::accumulate와 마지막 자릿수가 다를 수 있음
+// NaN이 섞인 경우 min/max 결과는 정의하지 않음
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CIRCULAR_BUFFER_SIMD_AVX2 1
+#include <immintrin.h>
+#define CIRCULAR_BUFFER_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CIRCULAR_BUFFER_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace circular_buffer_simd {
+
+// 합계/내적 결과 타입: 부동소수점은 double, 정수는 64비트로 넓혀 오버플로 방지
+template <typename T>
+using accum_type = std::conditional_t<std::is_floating_point_v<T>, double,
+                   std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+namespace detail {
+
+template <typename T>
+struct KernelTable {
+    accum_type<T> (*sum)(const T*, size_t);
+    T (*min)(const T*, size_t);  // n >= 1
+    T (*max)(const T*, size_t);  // n >= 1
+    accum_type<T> (*dot)(const T*, const T*, size_t);
+    size_t (*count_above)(const T*, size_t, T);  // x > threshold
+    size_t (*count_below)(const T*, size_t, T);  // x < threshold
+    const char* isa;
+};
+
+// ---- 스칼라 (모든 산술 타입) ----
+template <typename T>
+accum_type<T> sum_scalar(const T* p, size_t n) {
+    accum_type<T> r = 0;
+    for (size_t i = 0; i < n; ++i) r += p[i];
+    return r;
+}
+template <typename T>
+T min_scalar(const T* p, size_t n) {
+    T r = p[0];
+    for (size_t i = 1; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+template <typename T>
+T max_scalar(const T* p, size_t n) {
+    T r = p[0];
+    for (size_t i = 1; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+template <typename T>
+accum_type<T> dot_scalar(const T* a, const T* b, size_t n) {
+    accum_type<T> r = 0;
+    for (size_t i = 0; i < n; ++i) r += (accum_type<T>)a[i] * (accum_type<T>)b[i];
+    return r;
+}
+template <typename T>
+size_t count_above_scalar(const T* p, size_t n, T threshold) {
+    size_t c = 0;
+    for (size_t i = 0; i < n; ++i) c += p[i] > threshold;
+    return c;
+}
+template <typename T>
+size_t count_below_scalar(const T* p, size_t n, T threshold) {
+    size_t c = 0;
+    for (size_t i = 0; i < n; ++i) c += p[i] < threshold;
+    return c;
+}
+
+template <typename T>
+constexpr KernelTable<T> scalar_table() {
+    return {&sum_scalar<T>, &min_scalar<T>, &max_scalar<T>, &dot_scalar<T>,
+            &count_above_scalar<T>, &count_below_scalar<T>, "scalar"};
+}
+
+#if defined(CIRCULAR_BUFFER_SIMD_AVX2)
+// ---- AVX2 ----
+CIRCULAR_BUFFER_TARGET_AVX2 inline double hsum_pd(__m256d v) {
+    __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline std::int64_t hsum_epi64(__m256i v) {
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256((__m256i*)lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// float
+CIRCULAR_BUFFER_TARGET_AVX2 inline double sum_avx2(const float* p, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 v = _mm256_loadu_ps(p + i);
+        a0 = _mm256_add_pd(a0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        a1 = _mm256_add_pd(a1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    double r = hsum_pd(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) r += p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline float min_avx2(const float* p, size_t n) {
+    if (n < 8) return min_scalar(p, n);
+    __m256 m = _mm256_loadu_ps(p);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm256_min_ps(m, _mm256_loadu_ps(p + i));
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, m);
+    float r = min_scalar(lanes, 8);
+    for (; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline float max_avx2(const float* p, size_t n) {
+    if (n < 8) return max_scalar(p, n);
+    __m256 m = _mm256_loadu_ps(p);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm256_max_ps(m, _mm256_loadu_ps(p + i));
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, m);
+    float r = max_scalar(lanes, 8);
+    for (; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline double dot_avx2(const float* a, const float* b, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 va = _mm256_loadu_ps(a + i), vb = _mm256_loadu_ps(b + i);
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(va)),
+                                             _mm256_cvtps_pd(_mm256_castps256_ps128(vb))));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(va, 1)),
+                                             _mm256_cvtps_pd(_mm256_extractf128_ps(vb, 1))));
+    }
+    double r = hsum_pd(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) r += (double)a[i] * (double)b[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline size_t count_above_avx2(const float* p, size_t n, float threshold) {
+    const __m256 t = _mm256_set1_ps(threshold);
+    size_t c = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        c += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), t, _CMP_GT_OQ)));
+    }
+    return c + count_above_scalar(p + i, n - i, threshold);
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline size_t count_below_avx2(const float* p, size_t n, float threshold) {
+    const __m256 t = _mm256_set1_ps(threshold);
+    size_t c = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        c += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), t, _CMP_LT_OQ)));
+    }
+    return c + count_below_scalar(p + i, n - i, threshold);
+}
+
+// double
+CIRCULAR_BUFFER_TARGET_AVX2 inline double sum_avx2(const double* p, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+    }
+    double r = hsum_pd(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) r += p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline double min_avx2(const double* p, size_t n) {
+    if (n < 4) return min_scalar(p, n);
+    __m256d m = _mm256_loadu_pd(p);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) m = _mm256_min_pd(m, _mm256_loadu_pd(p + i));
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, m);
+    double r = min_scalar(lanes, 4);
+    for (; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline double max_avx2(const double* p, size_t n) {
+    if (n < 4) return max_scalar(p, n);
+    __m256d m = _mm256_loadu_pd(p);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) m = _mm256_max_pd(m, _mm256_loadu_pd(p + i));
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, m);
+    double r = max_scalar(lanes, 4);
+    for (; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline double dot_avx2(const double* a, const double* b, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    double r = hsum_pd(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i) r += a[i] * b[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline size_t count_above_avx2(const double* p, size_t n, double threshold) {
+    const __m256d t = _mm256_set1_pd(threshold);
+    size_t c = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), t, _CMP_GT_OQ)));
+    }
+    return c + count_above_scalar(p + i, n - i, threshold);
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline size_t count_below_avx2(const double* p, size_t n, double threshold) {
+    const __m256d t = _mm256_set1_pd(threshold);
+    size_t c = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), t, _CMP_LT_OQ)));
+    }
+    return c + count_below_scalar(p + i, n - i, threshold);
+}
+
+// int32_t (합계/내적은 64비트 lane으로 넓혀 누적)
+CIRCULAR_BUFFER_TARGET_AVX2 inline std::int64_t sum_avx2(const std::int32_t* p, size_t n) {
+    __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    std::int64_t r = hsum_epi64(_mm256_add_epi64(a0, a1));
+    for (; i < n; ++i) r += p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline std::int32_t min_avx2(const std::int32_t* p, size_t n) {
+    if (n < 8) return min_scalar(p, n);
+    __m256i m = _mm256_loadu_si256((const __m256i*)p);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i*)(p + i)));
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256((__m256i*)lanes, m);
+    std::int32_t r = min_scalar(lanes, 8);
+    for (; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline std::int32_t max_avx2(const std::int32_t* p, size_t n) {
+    if (n < 8) return max_scalar(p, n);
+    __m256i m = _mm256_loadu_si256((const __m256i*)p);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm256_max_epi32(m, _mm256_loadu_si256((const __m256i*)(p + i)));
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256((__m256i*)lanes, m);
+    std::int32_t r = max_scalar(lanes, 8);
+    for (; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline std::int64_t dot_avx2(const std::int32_t* a, const std::int32_t* b, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // _mm256_mul_epi32는 각 64비트 lane의 하위 32비트끼리 곱해 64비트 결과를 냄
+        const __m256i va = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(a + i)));
+        const __m256i vb = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(b + i)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(va, vb));
+    }
+    std::int64_t r = hsum_epi64(acc);
+    for (; i < n; ++i) r += (std::int64_t)a[i] * b[i];
+    return r;
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline size_t count_above_avx2(const std::int32_t* p, size_t n, std::int32_t threshold) {
+    const __m256i t = _mm256_set1_epi32(threshold);
+    size_t c = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i gt = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(p + i)), t);
+        c += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(gt)));
+    }
+    return c + count_above_scalar(p + i, n - i, threshold);
+}
+CIRCULAR_BUFFER_TARGET_AVX2 inline size_t count_below_avx2(const std::int32_t* p, size_t n, std::int32_t threshold) {
+    const __m256i t = _mm256_set1_epi32(threshold);
+    size_t c = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i lt = _mm256_cmpgt_epi32(t, _mm256_loadu_si256((const __m256i*)(p + i)));
+        c += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+    }
+    return c + count_below_scalar(p + i, n - i, threshold);
+}
+
+template <typename T>
+KernelTable<T> avx2_table() {
+    return {[](const T* p, size_t n) { return sum_avx2(p, n); },
+            [](const T* p, size_t n) { return min_avx2(p, n); },
+            [](const T* p, size_t n) { return max_avx2(p, n); },
+            [](const T* a, const T* b, size_t n) { return dot_avx2(a, b, n); },
+            [](const T* p, size_t n, T t) { return count_above_avx2(p, n, t); },
+            [](const T* p, size_t n, T t) { return count_below_avx2(p, n, t); },
+            "avx2"};
+}
+#endif  // CIRCULAR_BUFFER_SIMD_AVX2
+
+#if defined(CIRCULAR_BUFFER_SIMD_NEON)
+// ---- NEON (AArch64) ----
+// float
+inline double sum_neon(const float* p, size_t n) {
+    float64x2_t a0 = vdupq_n_f64(0.0), a1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t v = vld1q_f32(p + i);
+        a0 = vaddq_f64(a0, vcvt_f64_f32(vget_low_f32(v)));
+        a1 = vaddq_f64(a1, vcvt_high_f64_f32(v));
+    }
+    double r = vaddvq_f64(vaddq_f64(a0, a1));
+    for (; i < n; ++i) r += p[i];
+    return r;
+}
+inline float min_neon(const float* p, size_t n) {
+    if (n < 4) return min_scalar(p, n);
+    float32x4_t m = vld1q_f32(p);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) m = vminq_f32(m, vld1q_f32(p + i));
+    float r = vminvq_f32(m);
+    for (; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+inline float max_neon(const float* p, size_t n) {
+    if (n < 4) return max_scalar(p, n);
+    float32x4_t m = vld1q_f32(p);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) m = vmaxq_f32(m, vld1q_f32(p + i));
+    float r = vmaxvq_f32(m);
+    for (; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+inline double dot_neon(const float* a, const float* b, size_t n) {
+    float64x2_t a0 = vdupq_n_f64(0.0), a1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t va = vld1q_f32(a + i), vb = vld1q_f32(b + i);
+        a0 = vfmaq_f64(a0, vcvt_f64_f32(vget_low_f32(va)), vcvt_f64_f32(vget_low_f32(vb)));
+        a1 = vfmaq_f64(a1, vcvt_high_f64_f32(va), vcvt_high_f64_f32(vb));
+    }
+    double r = vaddvq_f64(vaddq_f64(a0, a1));
+    for (; i < n; ++i) r += (double)a[i] * (double)b[i];
+    return r;
+}
+inline size_t count_above_neon(const float* p, size_t n, float threshold) {
+    const float32x4_t t = vdupq_n_f32(threshold);
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = vsubq_u32(acc, vcgtq_f32(vld1q_f32(p + i), t));  // 참 = 0xFFFFFFFF(-1)
+    return vaddvq_u32(acc) + count_above_scalar(p + i, n - i, threshold);
+}
+inline size_t count_below_neon(const float* p, size_t n, float threshold) {
+    const float32x4_t t = vdupq_n_f32(threshold);
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = vsubq_u32(acc, vcltq_f32(vld1q_f32(p + i), t));
+    return vaddvq_u32(acc) + count_below_scalar(p + i, n - i, threshold);
+}
+
+// double
+inline double sum_neon(const double* p, size_t n) {
+    float64x2_t a0 = vdupq_n_f64(0.0), a1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 = vaddq_f64(a0, vld1q_f64(p + i));
+        a1 = vaddq_f64(a1, vld1q_f64(p + i + 2));
+    }
+    double r = vaddvq_f64(vaddq_f64(a0, a1));
+    for (; i < n; ++i) r += p[i];
+    return r;
+}
+inline double min_neon(const double* p, size_t n) {
+    if (n < 2) return min_scalar(p, n);
+    float64x2_t m = vld1q_f64(p);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) m = vminq_f64(m, vld1q_f64(p + i));
+    double r = vminvq_f64(m);
+    for (; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+inline double max_neon(const double* p, size_t n) {
+    if (n < 2) return max_scalar(p, n);
+    float64x2_t m = vld1q_f64(p);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) m = vmaxq_f64(m, vld1q_f64(p + i));
+    double r = vmaxvq_f64(m);
+    for (; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+inline double dot_neon(const double* a, const double* b, size_t n) {
+    float64x2_t a0 = vdupq_n_f64(0.0), a1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 = vfmaq_f64(a0, vld1q_f64(a + i), vld1q_f64(b + i));
+        a1 = vfmaq_f64(a1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+    }
+    double r = vaddvq_f64(vaddq_f64(a0, a1));
+    for (; i < n; ++i) r += a[i] * b[i];
+    return r;
+}
+inline size_t count_above_neon(const double* p, size_t n, double threshold) {
+    const float64x2_t t = vdupq_n_f64(threshold);
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) acc = vsubq_u64(acc, vcgtq_f64(vld1q_f64(p + i), t));
+    return (size_t)vaddvq_u64(acc) + count_above_scalar(p + i, n - i, threshold);
+}
+inline size_t count_below_neon(const double* p, size_t n, double threshold) {
+    const float64x2_t t = vdupq_n_f64(threshold);
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) acc = vsubq_u64(acc, vcltq_f64(vld1q_f64(p + i), t));
+    return (size_t)vaddvq_u64(acc) + count_below_scalar(p + i, n - i, threshold);
+}
+
+// int32_t
+inline std::int64_t sum_neon(const std::int32_t* p, size_t n) {
+    int64x2_t acc = vdupq_n_s64(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = vpadalq_s32(acc, vld1q_s32(p + i));  // 인접 2개씩 더해 64비트로 누적
+    std::int64_t r = vaddvq_s64(acc);
+    for (; i < n; ++i) r += p[i];
+    return r;
+}
+inline std::int32_t min_neon(const std::int32_t* p, size_t n) {
+    if (n < 4) return min_scalar(p, n);
+    int32x4_t m = vld1q_s32(p);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) m = vminq_s32(m, vld1q_s32(p + i));
+    std::int32_t r = vminvq_s32(m);
+    for (; i < n; ++i) if (p[i] < r) r = p[i];
+    return r;
+}
+inline std::int32_t max_neon(const std::int32_t* p, size_t n) {
+    if (n < 4) return max_scalar(p, n);
+    int32x4_t m = vld1q_s32(p);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) m = vmaxq_s32(m, vld1q_s32(p + i));
+    std::int32_t r = vmaxvq_s32(m);
+    for (; i < n; ++i) if (p[i] > r) r = p[i];
+    return r;
+}
+inline std::int64_t dot_neon(const std::int32_t* a, const std::int32_t* b, size_t n) {
+    int64x2_t a0 = vdupq_n_s64(0), a1 = vdupq_n_s64(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const int32x4_t va = vld1q_s32(a + i), vb = vld1q_s32(b + i);
+        a0 = vmlal_s32(a0, vget_low_s32(va), vget_low_s32(vb));
+        a1 = vmlal_high_s32(a1, va, vb);
+    }
+    std::int64_t r = vaddvq_s64(vaddq_s64(a0, a1));
+    for (; i < n; ++i) r += (std::int64_t)a[i] * b[i];
+    return r;
+}
+inline size_t count_above_neon(const std::int32_t* p, size_t n, std::int32_t threshold) {
+    const int32x4_t t = vdupq_n_s32(threshold);
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = vsubq_u32(acc, vcgtq_s32(vld1q_s32(p + i), t));
+    return vaddvq_u32(acc) + count_above_scalar(p + i, n - i, threshold);
+}
+inline size_t count_below_neon(const std::int32_t* p, size_t n, std::int32_t threshold) {
+    const int32x4_t t = vdupq_n_s32(threshold);
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = vsubq_u32(acc, vcltq_s32(vld1q_s32(p + i), t));
+    return vaddvq_u32(acc) + count_below_scalar(p + i, n - i, threshold);
+}
+
+template <typename T>
+KernelTable<T> neon_table() {
+    return {[](const T* p, size_t n) { return sum_neon(p, n); },
+            [](const T* p, size_t n) { return min_neon(p, n); },
+            [](const T* p, size_t n) { return max_neon(p, n); },
+            [](const T* a, const T* b, size_t n) { return dot_neon(a, b, n); },
+            [](const T* p, size_t n, T t) { return count_above_neon(p, n, t); },
+            [](const T* p, size_t n, T t) { return count_below_neon(p, n, t); },
+            "neon"};
+}
+#endif  // CIRCULAR_BUFFER_SIMD_NEON
+
+template <typename T>
+inline constexpr bool has_simd_kernels =
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>;
+
+template <typename T>
+KernelTable<T> select_kernels() {
+    if constexpr (has_simd_kernels<T>) {
+#if defined(CIRCULAR_BUFFER_SIMD_AVX2)
+        if (__builtin_cpu_supports("avx2")) return avx2_table<T>();
+#elif defined(CIRCULAR_BUFFER_SIMD_NEON)
+        return neon_table<T>();
+#endif
+    }
+    return scalar_table<T>();
+}
+
+// 타입별로 첫 호출 시 한 번만 선택
+template <typename T>
+const KernelTable<T>& kernels() {
+    static const KernelTable<T> table = select_kernels<T>();
+    return table;
+}
+
+}  // namespace detail
+
+// 타입 T에 대해 선택된 구현 이름 ("avx2" / "neon" / "scalar")
+template <typename T>
+const char* active_isa() {
+    return detail::kernels<std::remove_cv_t<T>>().isa;
+}
+
+// ---- 연속 구간 커널 ----
+template <typename T>
+accum_type<T> sum(std::span<const T> s) {
+    return detail::kernels<T>().sum(s.data(), s.size());
+}
+template <typename T>
+T min(std::span<const T> s) {  // s는 비어 있으면 안 됨
+    return detail::kernels<T>().min(s.data(), s.size());
+}
+template <typename T>
+T max(std::span<const T> s) {  // s는 비어 있으면 안 됨
+    return detail::kernels<T>().max(s.data(), s.size());
+}
+template <typename T>
+accum_type<T> dot(std::span<const T> a, std::span<const T> b) {  // a.size() <= b.size()
+    return detail::kernels<T>().dot(a.data(), b.data(), a.size());
+}
+template <typename T>
+size_t count_above(std::span<const T> s, T threshold) {
+    return detail::kernels<T>().count_above(s.data(), s.size(), threshold);
+}
+template <typename T>
+size_t count_below(std::span<const T> s, T threshold) {
+    return detail::kernels<T>().count_below(s.data(), s.size(), threshold);
+}
+
+// ---- CircularBuffer 전체 (두 구간 결과를 합침) ----
+template <typename T, size_t N, typename A>
+accum_type<T> sum(const CircularBuffer<T, N, A>& buf) {
+    const auto seg = buf.segments();
+    return sum(seg[0]) + sum(seg[1]);
+}
+template <typename T, size_t N, typename A>
+T min(const CircularBuffer<T, N, A>& buf) {  // buf는 비어 있으면 안 됨
+    const auto seg = buf.segments();
+    const T a = min(seg[0]);
+    if (seg[1].empty()) return a;
+    const T b = min(seg[1]);
+    return b < a ? b : a;
+}
+template <typename T, size_t N, typename A>
+T max(const CircularBuffer<T, N, A>& buf) {  // buf는 비어 있으면 안 됨
+    const auto seg = buf.segments();
+    const T a = max(seg[0]);
+    if (seg[1].empty()) return a;
+    const T b = max(seg[1]);
+    return b > a ? b : a;
+}
+// weights[0]이 가장 오래된 데이터와 곱해짐 (FIR 필터 등). weights.size() >= buf.size()
+template <typename T, size_t N, typename A>
+accum_type<T> dot(const CircularBuffer<T, N, A>& buf, std::span<const T> weights) {
+    const auto seg = buf.segments();
+    return dot(seg[0], weights.first(seg[0].size())) + dot(seg[1], weights.subspan(seg[0].size()));
+}
+template <typename T, size_t N, typename A>
+size_t count_above(const CircularBuffer<T, N, A>& buf, T threshold) {
+    const auto seg = buf.segments();
+    return count_above(seg[0], threshold) + count_above(seg[1], threshold);
+}
+template <typename T, size_t N, typename A>
+size_t count_below(const CircularBuffer<T, N, A>& buf, T threshold) {
+    const auto seg = buf.segments();
+    return count_below(seg[0], threshold) + count_below(seg[1], threshold);
+}
+
+}  // namespace circular_buffer_simd
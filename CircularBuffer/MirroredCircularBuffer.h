@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "CircularBuffer.h"
+
+namespace circular_buffer_detail {
+
+    // 같은 물리 페이지를 가상 주소 공간에 두 번 연속으로 매핑한 영역
+    // [base, base + bytes)와 [base + bytes, base + 2 * bytes)가 같은 메모리를 가리킴
+    class MirroredMapping {
+    private:
+        std::uint8_t* base = nullptr;
+        std::size_t m_bytes = 0;
+
+    public:
+        // 매핑 단위 (Linux: 페이지 크기, Windows: 할당 단위 64KB)
+        static std::size_t granularity() {
+#if defined(_WIN32)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+#else
+            return (std::size_t)sysconf(_SC_PAGESIZE);
+#endif
+        }
+
+        // bytes는 granularity()의 배수여야 함
+        explicit MirroredMapping(std::size_t bytes) : m_bytes(bytes) {
+#if defined(_WIN32)
+            HANDLE section = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                                (DWORD)((std::uint64_t)bytes >> 32), (DWORD)bytes, nullptr);
+            if (!section) throw std::runtime_error("미러 버퍼용 메모리를 만들 수 없습니다");
+
+            // 2 * bytes 크기의 빈 주소를 찾은 뒤 해제하고 그 자리에 두 번 매핑
+            // (해제와 매핑 사이에 다른 스레드가 주소를 가져갈 수 있으므로 재시도)
+            for (int attempt = 0; attempt < 16 && !base; ++attempt) {
+                void* hint = VirtualAlloc(nullptr, 2 * bytes, MEM_RESERVE, PAGE_NOACCESS);
+                if (!hint) break;
+                VirtualFree(hint, 0, MEM_RELEASE);
+
+                void* first = MapViewOfFileEx(section, FILE_MAP_ALL_ACCESS, 0, 0, bytes, hint);
+                if (!first) continue;
+                void* second = MapViewOfFileEx(section, FILE_MAP_ALL_ACCESS, 0, 0, bytes,
+                                               (std::uint8_t*)hint + bytes);
+                if (!second) {
+                    UnmapViewOfFile(first);
+                    continue;
+                }
+                base = (std::uint8_t*)first;
+            }
+            CloseHandle(section);  // 매핑된 view가 section을 계속 유지함
+            if (!base) throw std::runtime_error("미러 버퍼를 매핑할 수 없습니다");
+#else
+#if defined(__linux__)
+            const int fd = memfd_create("circular_buffer", MFD_CLOEXEC);
+#else
+            // memfd가 없는 POSIX: 임시 공유 메모리 객체를 만들고 이름은 바로 제거
+            const std::string name = "/circular_buffer_" + std::to_string((long)getpid()) + "_" +
+                                     std::to_string((std::uintptr_t)this);
+            const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd >= 0) shm_unlink(name.c_str());
+#endif
+            if (fd < 0) throw std::runtime_error("미러 버퍼용 메모리를 만들 수 없습니다");
+            if (ftruncate(fd, (off_t)bytes) != 0) {
+                close(fd);
+                throw std::runtime_error("미러 버퍼 크기를 설정할 수 없습니다");
+            }
+
+            // 2 * bytes 주소 공간을 예약한 뒤 앞/뒤 절반에 같은 fd를 MAP_FIXED로 매핑
+            void* reserved = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (reserved == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("미러 버퍼 주소 공간을 예약할 수 없습니다");
+            }
+            std::uint8_t* p = (std::uint8_t*)reserved;
+            const bool ok =
+                mmap(p, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+                mmap(p + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+            close(fd);  // 매핑이 파일을 계속 유지함
+            if (!ok) {
+                munmap(reserved, 2 * bytes);
+                throw std::runtime_error("미러 버퍼를 매핑할 수 없습니다");
+            }
+            base = p;
+#endif
+        }
+
+        ~MirroredMapping() {
+            if (!base) return;
+#if defined(_WIN32)
+            UnmapViewOfFile(base + m_bytes);
+            UnmapViewOfFile(base);
+#else
+            munmap(base, 2 * m_bytes);
+#endif
+        }
+
+        MirroredMapping(const MirroredMapping&) = delete;
+        MirroredMapping& operator=(const MirroredMapping&) = delete;
+
+        std::uint8_t* data() const { return base; }
+        std::size_t bytes() const { return m_bytes; }
+    };
+}
+
+// "magic ring" 원형 버퍼: 같은 메모리를 두 번 이어 붙여 매핑하므로
+// [head, head + size) 구간이 래핑 지점과 무관하게 항상 하나의 연속 포인터 범위
+// - 래핑 지점을 걸친 가변 길이 레코드도 복사 없이 contiguous()로 바로 파싱 가능
+// - 쓰기 쪽도 write_region()에 직접 채운 뒤 commit()으로 확정 가능 (read()/recv() 등)
+// - 용량은 (용량 * sizeof(T))가 매핑 단위의 배수가 되도록 올림
+// - 같은 원소가 두 주소에서 보이므로 trivially copyable 타입만 허용
+template <typename T>
+class MirroredCircularBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "MirroredCircularBuffer는 trivially copyable 타입만 지원합니다");
+
+private:
+    static std::size_t mapping_bytes(std::size_t capacity) {
+        const std::size_t g = circular_buffer_detail::MirroredMapping::granularity();
+        const std::size_t unit = g / std::gcd(g, sizeof(T)) * sizeof(T);  // lcm(g, sizeof(T))
+        const std::size_t bytes = (capacity == 0 ? 1 : capacity) * sizeof(T);
+        return (bytes + unit - 1) / unit * unit;
+    }
+
+    circular_buffer_detail::MirroredMapping mapping;
+    T* buffer;
+    circular_buffer_detail::SlotIndexer index;
+    size_t head = 0;  // 가장 오래된 데이터의 위치 (단조 증가)
+    size_t tail = 0;  // 다음에 추가될 위치 (단조 증가)
+
+    T* at_pos(size_t pos) const { return buffer + index(pos); }
+
+public:
+    explicit MirroredCircularBuffer(size_t capacity)
+        : mapping(mapping_bytes(capacity)),
+          buffer((T*)mapping.data()),
+          index(mapping.bytes() / sizeof(T), CapacityPolicy::Exact) {}
+
+    size_t size() const { return tail - head; }
+    size_t capacity() const { return index.capacity(); }
+    bool empty() const { return head == tail; }
+
+    void pop_front() {
+        if (!empty()) head++;
+    }
+    void pop_front(size_t n) { head += n < size() ? n : size(); }
+    void clear() { head = tail; }
+
+    // 가득 차면 가장 오래된 데이터를 덮어씀 (CircularBuffer::push_back과 동일)
+    void push_back(const T& item) {
+        if (size() == capacity()) head++;
+        *at_pos(tail) = item;
+        tail++;
+    }
+
+    // n개를 memcpy 한 번으로 추가 (미러 덕분에 래핑 지점에서 나눌 필요 없음)
+    void push_back(const T* first, size_t n) {
+        if (n >= capacity()) {
+            first += n - capacity();
+            n = capacity();
+            head = tail;
+        } else if (size() + n > capacity()) {
+            head += size() + n - capacity();
+        }
+        std::memcpy(at_pos(tail), first, n * sizeof(T));
+        tail += n;
+    }
+
+    T& front() { return *at_pos(head); }
+    const T& front() const { return *at_pos(head); }
+    T& back() { return *at_pos(tail - 1); }
+    const T& back() const { return *at_pos(tail - 1); }
+
+    // 논리 순서 기준 접근 (0 = 가장 오래된 데이터)
+    T& operator[](size_t i) { return *at_pos(head + i); }
+    const T& operator[](size_t i) const { return *at_pos(head + i); }
+
+    // 가장 오래된 데이터부터 size()개가 연속으로 놓인 포인터
+    T* data() { return at_pos(head); }
+    const T* data() const { return at_pos(head); }
+
+    // 현재 내용 전체를 하나의 연속 구간으로 반환
+    std::span<T> contiguous() { return std::span<T>(data(), size()); }
+    std::span<const T> contiguous() const { return std::span<const T>(data(), size()); }
+
+    // 비어 있는 공간 전체를 하나의 연속 구간으로 반환 (직접 채운 뒤 commit(n) 호출)
+    std::span<T> write_region() { return std::span<T>(at_pos(tail), capacity() - size()); }
+
+    // write_region()에 채운 앞쪽 n개를 내용에 추가 (n <= capacity() - size())
+    void commit(size_t n) { tail += n; }
+};
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CircularBuffer.h"
+#include "WaitGate.h"
+
+// 다중 생산자 / 다중 소비자용 bounded lock-free 원형 버퍼 (Vyukov 방식)
+// - 슬롯마다 sequence 번호를 두어 전역 락 없이 push/pop 위치를 CAS로 확보
+// - enqueue/dequeue 위치와 각 슬롯을 캐시 라인 단위로 분리해 코어 간 ping-pong 최소화
+// - CircularBuffer와 같은 이름의 인터페이스 제공 (push_back, front, pop_front, size)
+// - ConsumerWait::Blocking이면 wait_pop/wait_pop_n으로 데이터를 기다릴 수 있음
+template <typename T, ConsumerWait Wait = ConsumerWait::None>
+class MpmcCircularBuffer {
+private:
+    using clock = std::chrono::steady_clock;
+    static constexpr size_t line = circular_buffer_detail::cache_line_size;
+    struct NoGate {};
+
+    // sequence == pos           : pos 번째 push를 기다리는 빈 슬롯
+    // sequence == pos + 1       : pos 번째 push가 끝나 pop 가능한 슬롯
+    // sequence == pos + capacity: pop이 끝나 다음 바퀴의 push를 기다리는 슬롯
+    struct alignas(line) Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    circular_buffer_detail::SlotIndexer index;
+    size_t m_capacity;
+    std::unique_ptr<Cell[]> buffer;
+
+    alignas(line) std::atomic<size_t> enqueue_pos{0};
+    alignas(line) std::atomic<size_t> dequeue_pos{0};
+
+    // ConsumerWait::Blocking일 때만 실제 관문을 둠 (None이면 크기 0)
+    alignas(line) [[no_unique_address]]
+    std::conditional_t<Wait == ConsumerWait::Blocking, circular_buffer_detail::WaitGate, NoGate> gate;
+
+    static std::intptr_t distance(size_t seq, size_t pos) {
+        return (std::intptr_t)seq - (std::intptr_t)pos;
+    }
+
+    // push 위치를 확보한 뒤 fill(슬롯 데이터)로 채움. 가득 차면 false
+    template <typename F>
+    bool enqueue(F&& fill) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = buffer[index(pos)];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = distance(seq, pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(cell.data);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    if constexpr (Wait == ConsumerWait::Blocking) {
+                        gate.notify([&] { return size(); });
+                    }
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // 한 바퀴 전 데이터가 아직 pop되지 않음 -> 가득 참
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // pop 위치를 확보한 뒤 drain(슬롯 데이터)로 꺼냄. 비어 있으면 false
+    template <typename F>
+    bool dequeue(F&& drain) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = buffer[index(pos)];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = distance(seq, pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    drain(cell.data);
+                    cell.sequence.store(pos + m_capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // 아직 push되지 않은 슬롯 -> 비어 있음
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 소비자가 여럿이므로 관문은 1개 단위로 깨우고, n개 조건은 깨어난 소비자가 재확인
+    bool wait_ready_until(size_t n, clock::time_point deadline) {
+        static_assert(Wait == ConsumerWait::Blocking, "wait_pop은 ConsumerWait::Blocking에서만 사용할 수 있습니다");
+        n = std::min(n, m_capacity);
+        return gate.wait_until([&] { return size() >= n; }, 1, deadline);
+    }
+
+    size_t wait_pop_n_until(T* out, size_t n, clock::time_point deadline) {
+        n = std::min(n, m_capacity);
+        wait_ready_until(n, deadline);
+        size_t popped = 0;
+        while (popped < n && try_pop(out[popped])) popped++;
+        return popped;
+    }
+
+    template <typename Rep, typename Period>
+    static clock::time_point deadline_after(std::chrono::duration<Rep, Period> timeout) {
+        return clock::now() + std::chrono::ceil<clock::duration>(timeout);
+    }
+
+    // pos 번째 데이터를 pop하지 않고 복사. 복사 도중 슬롯이 바뀌었으면 false
+    bool peek(size_t pos, T& out) const {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "front/snapshot은 trivially copyable 타입만 지원합니다");
+        const Cell& cell = buffer[index(pos)];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        T value = cell.data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (cell.sequence.load(std::memory_order_relaxed) != pos + 1) return false;
+        out = value;
+        return true;
+    }
+
+    // 용량이 1이면 "pop 끝남(pos + capacity)"과 "push 끝남(pos + 1)"이 같은 값이 되어 구분할 수 없음
+    static size_t checked_capacity(size_t capacity) {
+        if (capacity < 2) throw std::invalid_argument("MPMC 버퍼 용량은 2 이상이어야 합니다");
+        return capacity;
+    }
+
+public:
+    // capacity < 2이면 std::invalid_argument
+    explicit MpmcCircularBuffer(size_t capacity, CapacityPolicy policy = CapacityPolicy::Exact)
+        : index(checked_capacity(capacity), policy), m_capacity(index.capacity()), buffer(new Cell[m_capacity]) {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcCircularBuffer(const MpmcCircularBuffer&) = delete;
+    MpmcCircularBuffer& operator=(const MpmcCircularBuffer&) = delete;
+
+    size_t capacity() const { return m_capacity; }
+
+    // 다른 스레드가 동시에 수정 중일 수 있으므로 근사값
+    size_t size() const {
+        const size_t d = dequeue_pos.load(std::memory_order_acquire);
+        const size_t e = enqueue_pos.load(std::memory_order_acquire);
+        return e > d ? e - d : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    // 가득 차면 false (데이터 유실 없음)
+    bool try_push(const T& item) {
+        return enqueue([&](T& data) { data = item; });
+    }
+    bool try_push(T&& item) {
+        return enqueue([&](T& data) { data = std::move(item); });
+    }
+
+    // 비어 있으면 false
+    bool try_pop(T& out) {
+        return dequeue([&](T& data) { out = std::move(data); });
+    }
+
+    // 슬롯을 복사 없이 직접 채우거나 비움: fill(T& slot) / drain(T& slot)
+    // 콜백 실행 중에는 해당 슬롯이 확보된 상태이므로 짧게 끝나야 함 (다른 소비자/생산자가 그 위치에서 대기)
+    template <typename F>
+    bool try_push_with(F&& fill) {
+        return enqueue(std::forward<F>(fill));
+    }
+    template <typename F>
+    bool try_pop_with(F&& drain) {
+        return dequeue(std::forward<F>(drain));
+    }
+
+    // CircularBuffer::push_back과 동일하게 가득 차면 가장 오래된 데이터를 버리고 추가
+    void push_back(const T& item) {
+        while (!try_push(item)) {
+            pop_front();
+        }
+    }
+
+    // 가장 오래된 데이터 하나를 버림. 비어 있으면 false
+    bool pop_front() {
+        return dequeue([](T&) {});
+    }
+
+    // 가장 오래된 데이터를 pop하지 않고 복사. 비어 있거나 경쟁에서 밀리면 false
+    bool front(T& out) const {
+        for (;;) {
+            const size_t pos = dequeue_pos.load(std::memory_order_acquire);
+            if (peek(pos, out)) return true;
+            if (pos == enqueue_pos.load(std::memory_order_acquire)) return false;
+        }
+    }
+
+    // 현재 내용을 오래된 순서로 복사 (범위 기반 for문으로 순회)
+    // 복사 도중 pop/overwrite된 슬롯은 건너뛰므로 각 원소는 일관되지만 전체는 근사 스냅샷
+    std::vector<T> snapshot() const {
+        std::vector<T> result;
+        const size_t d = dequeue_pos.load(std::memory_order_acquire);
+        const size_t e = enqueue_pos.load(std::memory_order_acquire);
+        if (e <= d) return result;
+        result.reserve(e - d);
+        T value;
+        for (size_t pos = d; pos != e; ++pos) {
+            if (peek(pos, value)) result.push_back(value);
+        }
+        return result;
+    }
+
+    // ConsumerWait::Blocking 전용. 데이터가 생길 때까지 대기 후 하나를 꺼냄
+    // (다른 소비자와 경쟁에서 밀리면 다시 대기)
+    bool wait_pop(T& out) {
+        while (wait_pop_n_until(&out, 1, clock::time_point::max()) == 0) {
+        }
+        return true;
+    }
+
+    // timeout 안에 데이터를 얻지 못하면 false
+    template <typename Rep, typename Period>
+    bool wait_pop(T& out, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = deadline_after(timeout);
+        for (;;) {
+            if (wait_pop_n_until(&out, 1, deadline) == 1) return true;
+            if (clock::now() >= deadline) return false;
+        }
+    }
+
+    // n개(capacity를 넘으면 capacity개)가 쌓이거나 timeout이 지날 때까지 꺼내지 않고 대기
+    // 깨어난 뒤 try_pop_with로 슬롯을 직접 비우는 소비자용. 준비되었으면 true
+    template <typename Rep, typename Period>
+    bool wait_ready(size_t n, std::chrono::duration<Rep, Period> timeout) {
+        return wait_ready_until(n, deadline_after(timeout));
+    }
+
+    // n개(capacity를 넘으면 capacity개)가 쌓이거나 timeout이 지날 때까지 대기한 뒤 최대 n개를 꺼냄
+    // 다른 소비자와 경쟁하므로 n개보다 적게 꺼낼 수 있음. 꺼낸 개수 반환
+    template <typename Rep, typename Period>
+    size_t wait_pop_n(T* out, size_t n, std::chrono::duration<Rep, Period> timeout) {
+        return wait_pop_n_until(out, n, deadline_after(timeout));
+    }
+};
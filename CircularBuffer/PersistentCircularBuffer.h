@@ -0,0 +1,331 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "CircularBuffer.h"
+
+namespace circular_buffer_detail {
+
+    // 파일 전체를 공유 매핑한 영역 (다른 프로세스와 같은 페이지를 봄)
+    class FileMapping {
+    private:
+        std::uint8_t* base = nullptr;
+        std::size_t m_bytes = 0;
+        bool m_created = false;  // 새로 만들었거나 비어 있던 파일 -> 헤더 초기화 필요
+
+    public:
+        // read_only가 아니면 파일이 없거나 비어 있을 때 bytes 크기로 만듦
+        // 기존 파일은 현재 크기 그대로 매핑 (크기 검증은 호출자가 헤더로 수행)
+        FileMapping(const std::string& path, std::size_t bytes, bool read_only) {
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path.c_str(), read_only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                      read_only ? OPEN_EXISTING : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("버퍼 파일을 열 수 없습니다: " + path);
+            LARGE_INTEGER size;
+            GetFileSizeEx(file, &size);
+            m_bytes = (std::size_t)size.QuadPart;
+            if (m_bytes == 0 && !read_only) {
+                m_bytes = bytes;
+                m_created = true;
+            }
+            if (m_bytes == 0) {
+                CloseHandle(file);
+                throw std::runtime_error("비어 있는 버퍼 파일입니다: " + path);
+            }
+            // 쓰기 매핑은 파일을 m_bytes까지 늘림 (늘어난 부분은 0)
+            HANDLE section = CreateFileMappingA(file, nullptr, read_only ? PAGE_READONLY : PAGE_READWRITE,
+                                                (DWORD)((std::uint64_t)m_bytes >> 32), (DWORD)m_bytes, nullptr);
+            CloseHandle(file);
+            if (!section) throw std::runtime_error("버퍼 파일을 매핑할 수 없습니다: " + path);
+            base = (std::uint8_t*)MapViewOfFile(section, read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, m_bytes);
+            CloseHandle(section);
+            if (!base) throw std::runtime_error("버퍼 파일을 매핑할 수 없습니다: " + path);
+#else
+            const int fd = read_only ? open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                                     : open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0) throw std::runtime_error("버퍼 파일을 열 수 없습니다: " + path);
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                close(fd);
+                throw std::runtime_error("버퍼 파일 정보를 읽을 수 없습니다: " + path);
+            }
+            m_bytes = (std::size_t)st.st_size;
+            if (m_bytes == 0 && !read_only) {
+                if (ftruncate(fd, (off_t)bytes) != 0) {
+                    close(fd);
+                    throw std::runtime_error("버퍼 파일 크기를 설정할 수 없습니다: " + path);
+                }
+                m_bytes = bytes;
+                m_created = true;
+            }
+            if (m_bytes == 0) {
+                close(fd);
+                throw std::runtime_error("비어 있는 버퍼 파일입니다: " + path);
+            }
+            void* p = mmap(nullptr, m_bytes, read_only ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);  // 매핑이 파일을 계속 유지함
+            if (p == MAP_FAILED) throw std::runtime_error("버퍼 파일을 매핑할 수 없습니다: " + path);
+            base = (std::uint8_t*)p;
+#endif
+        }
+
+        ~FileMapping() {
+            if (!base) return;
+#if defined(_WIN32)
+            UnmapViewOfFile(base);
+#else
+            munmap(base, m_bytes);
+#endif
+        }
+
+        FileMapping(const FileMapping&) = delete;
+        FileMapping& operator=(const FileMapping&) = delete;
+
+        // 변경 내용을 디스크에 기록 (프로세스 crash는 flush 없이도 살아남고, 전원 손실 대비용)
+        void flush() {
+#if defined(_WIN32)
+            FlushViewOfFile(base, m_bytes);
+#else
+            msync(base, m_bytes, MS_SYNC);
+#endif
+        }
+
+        std::uint8_t* data() const { return base; }
+        std::size_t bytes() const { return m_bytes; }
+        bool created() const { return m_created; }
+    };
+}
+
+// 파일 기반 원형 버퍼: 슬롯 배열과 헤더(head, tail, 용량, 원소 크기, generation)가
+// mmap된 파일 안에 있으므로 프로세스가 죽어도 마지막 capacity개가 파일에 남음
+// - 다시 열면 헤더 검증만으로 O(1) 복구 (파싱/역직렬화 없음)
+// - 다른 프로세스가 읽기 전용으로 같은 파일에 붙어 snapshot()으로 일관된 내용을 읽을 수 있음
+// - generation은 seqlock 카운터: 수정 중이면 홀수, 끝나면 짝수
+// - 크기는 단조 증가하는 tail - head로 구하므로 별도 size 필드는 두지 않음
+// - 파일에 그대로 기록하므로 trivially copyable 타입만 허용 (같은 ABI의 프로세스끼리 공유)
+template <typename T>
+class PersistentCircularBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "PersistentCircularBuffer는 trivially copyable 타입만 지원합니다");
+
+public:
+    // 읽기 전용 모드 선택용 태그
+    struct ReadOnly {};
+
+private:
+    static constexpr char magic_value[8] = {'C', 'B', 'U', 'F', 'P', 'E', 'R', 'S'};
+    static constexpr std::uint32_t format_version = 1;
+
+    // 파일 앞부분에 놓이는 헤더. 필드 순서/크기가 파일 형식이므로 바꾸면 format_version 증가
+    struct alignas(circular_buffer_detail::cache_line_size) Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t element_size;
+        std::uint64_t capacity;
+        std::uint64_t head;        // 가장 오래된 데이터의 위치 (단조 증가)
+        std::uint64_t tail;        // 다음에 추가될 위치 (단조 증가)
+        std::uint64_t generation;  // seqlock 카운터
+    };
+
+    static constexpr size_t slots_offset =
+        (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    static size_t file_bytes(size_t capacity) { return slots_offset + capacity * sizeof(T); }
+
+    circular_buffer_detail::FileMapping mapping;
+    Header* header;
+    T* buffer;
+    circular_buffer_detail::SlotIndexer index;
+    bool m_read_only;
+
+    // 헤더 필드는 다른 프로세스와 공유되므로 atomic_ref로 접근
+    static std::uint64_t load(std::uint64_t& field, std::memory_order order = std::memory_order_acquire) {
+        return std::atomic_ref<std::uint64_t>(field).load(order);
+    }
+    static void store(std::uint64_t& field, std::uint64_t value, std::memory_order order = std::memory_order_release) {
+        std::atomic_ref<std::uint64_t>(field).store(value, order);
+    }
+
+    T* at_pos(std::uint64_t pos) const { return buffer + index((size_t)pos); }
+
+    // 수정 구간 시작/끝 (generation 홀수 -> 짝수)
+    void begin_write() {
+        store(header->generation, load(header->generation, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    void end_write() { store(header->generation, load(header->generation, std::memory_order_relaxed) + 1); }
+
+    void require_writable() const {
+        if (m_read_only) throw std::runtime_error("읽기 전용으로 연 버퍼에는 기록할 수 없습니다");
+    }
+
+    // 기존 파일의 헤더가 이 타입/용량과 맞는지 검사. capacity == 0이면 파일의 용량을 따름
+    static Header* validate(circular_buffer_detail::FileMapping& mapping, size_t capacity) {
+        if (mapping.bytes() < sizeof(Header)) throw std::runtime_error("버퍼 파일 헤더가 손상되었습니다");
+        Header* h = (Header*)mapping.data();
+        if (std::memcmp(h->magic, magic_value, sizeof(magic_value)) != 0 || h->version != format_version)
+            throw std::runtime_error("버퍼 파일 형식이 아닙니다");
+        if (h->element_size != sizeof(T)) throw std::runtime_error("버퍼 파일의 원소 크기가 다릅니다");
+        if (capacity != 0 && h->capacity != capacity) throw std::runtime_error("버퍼 파일의 용량이 다릅니다");
+        if (h->capacity == 0 || mapping.bytes() < file_bytes((size_t)h->capacity))
+            throw std::runtime_error("버퍼 파일 크기가 헤더와 맞지 않습니다");
+        // 다른 프로세스가 쓰는 중일 수 있으므로 generation이 그대로인 동안 읽은 값이 틀릴 때만 손상으로 판단
+        for (;;) {
+            const std::uint64_t g = load(h->generation);
+            const bool ok = range_valid(load(h->head), load(h->tail), h->capacity);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (ok) break;
+            if (load(h->generation, std::memory_order_relaxed) == g)
+                throw std::runtime_error("버퍼 파일 헤더가 손상되었습니다");
+        }
+        return h;
+    }
+
+    static bool range_valid(std::uint64_t head, std::uint64_t tail, std::uint64_t capacity) {
+        return tail >= head && tail - head <= capacity;
+    }
+
+    // 크기는 맞지만 magic이 전부 0 -> ftruncate 뒤 헤더를 다 쓰기 전에 crash한 파일이므로 새로 초기화
+    bool interrupted_init(size_t capacity) const {
+        static constexpr char zero_magic[sizeof(magic_value)] = {};
+        return mapping.bytes() == file_bytes(capacity) &&
+               std::memcmp(mapping.data(), zero_magic, sizeof(zero_magic)) == 0;
+    }
+
+    Header* init_or_validate(size_t capacity) {
+        if (!mapping.created() && !interrupted_init(capacity)) return validate(mapping, capacity);
+        Header* h = (Header*)mapping.data();
+        h->version = format_version;
+        h->element_size = sizeof(T);
+        h->capacity = capacity;
+        h->head = 0;
+        h->tail = 0;
+        h->generation = 0;
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(h->magic, magic_value, sizeof(magic_value));  // magic은 마지막에 기록 (초기화 도중 crash하면 0으로 남아 다음에 열 때 다시 초기화)
+        return h;
+    }
+
+public:
+    // 파일이 없거나 비어 있으면 capacity로 새로 만들고, 있으면 그대로 복구
+    // (기존 파일의 용량/원소 크기가 다르면 예외)
+    PersistentCircularBuffer(const std::string& path, size_t capacity)
+        : mapping(path, file_bytes(capacity == 0 ? 1 : capacity), false),
+          header(init_or_validate(capacity == 0 ? 1 : capacity)),
+          buffer((T*)(mapping.data() + slots_offset)),
+          index((size_t)header->capacity, CapacityPolicy::Exact),
+          m_read_only(false) {
+        // push 도중 crash -> generation이 홀수로 남음
+        // head/tail은 슬롯 기록 전후로만 바뀌므로 [head, tail) 범위는 항상 유효, 카운터만 짝수로 복원
+        if (load(header->generation) % 2 != 0) end_write();
+    }
+
+    // 다른 프로세스가 쓰고 있는 파일에 읽기 전용으로 붙음 (용량은 파일에서 읽음)
+    PersistentCircularBuffer(const std::string& path, ReadOnly)
+        : mapping(path, 0, true),
+          header(validate(mapping, 0)),
+          buffer((T*)(mapping.data() + slots_offset)),
+          index((size_t)header->capacity, CapacityPolicy::Exact),
+          m_read_only(true) {}
+
+    PersistentCircularBuffer(const PersistentCircularBuffer&) = delete;
+    PersistentCircularBuffer& operator=(const PersistentCircularBuffer&) = delete;
+
+    size_t size() const { return (size_t)(load(header->tail) - load(header->head)); }
+    size_t capacity() const { return index.capacity(); }
+    bool empty() const { return size() == 0; }
+    bool read_only() const { return m_read_only; }
+    std::uint64_t generation() const { return load(header->generation); }
+
+    // 가득 차면 가장 오래된 데이터를 덮어씀 (CircularBuffer::push_back과 동일)
+    // 덮어쓸 슬롯은 head를 먼저 옮겨 범위 밖으로 뺀 뒤 기록하므로 crash 시에도 [head, tail)은 온전함
+    void push_back(const T& item) {
+        require_writable();
+        const std::uint64_t h = load(header->head, std::memory_order_relaxed);
+        const std::uint64_t t = load(header->tail, std::memory_order_relaxed);
+        begin_write();
+        if (t - h == capacity()) store(header->head, h + 1);
+        std::memcpy((void*)at_pos(t), &item, sizeof(T));
+        store(header->tail, t + 1);
+        end_write();
+    }
+
+    void pop_front() {
+        require_writable();
+        const std::uint64_t h = load(header->head, std::memory_order_relaxed);
+        if (h == load(header->tail, std::memory_order_relaxed)) return;
+        begin_write();
+        store(header->head, h + 1);
+        end_write();
+    }
+
+    void clear() {
+        require_writable();
+        begin_write();
+        store(header->head, load(header->tail, std::memory_order_relaxed));
+        end_write();
+    }
+
+    // 쓰기 프로세스용 직접 접근 (읽기 전용 프로세스는 동시 수정 중일 수 있으므로 snapshot() 사용)
+    const T& front() const { return *at_pos(load(header->head)); }
+    const T& back() const { return *at_pos(load(header->tail) - 1); }
+    const T& operator[](size_t i) const { return *at_pos(load(header->head) + i); }
+
+    // 현재 내용을 오래된 순서로 복사. 복사 도중 쓰기가 끼어들면 다시 시도하므로 항상 일관된 스냅샷
+    // generation이 홀수로 오래 멈춰 있으면 쓰기 프로세스가 기록 도중 죽은 것으로 보고 현재 [head, tail)을 읽음
+    std::vector<T> snapshot() const {
+        static constexpr int stalled_writer_retries = 1000;
+        std::vector<T> result;
+        int odd_retries = 0;
+        for (;;) {
+            const std::uint64_t g = load(header->generation);
+            if (g % 2 != 0 && odd_retries++ < stalled_writer_retries) {
+                std::this_thread::yield();
+                continue;
+            }
+            const std::uint64_t h = load(header->head);
+            const std::uint64_t t = load(header->tail);
+            if (!range_valid(h, t, capacity())) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (load(header->generation, std::memory_order_relaxed) == g)
+                    throw std::runtime_error("버퍼 파일 헤더가 손상되었습니다");
+                continue;
+            }
+            result.resize((size_t)(t - h));
+            for (std::uint64_t pos = h; pos != t; ++pos) {
+                std::memcpy((void*)&result[(size_t)(pos - h)], (const void*)at_pos(pos), sizeof(T));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (load(header->generation, std::memory_order_relaxed) == g) return result;
+        }
+    }
+
+    // 디스크까지 기록 (프로세스 crash만 대비한다면 불필요)
+    void flush() {
+        require_writable();
+        mapping.flush();
+    }
+};
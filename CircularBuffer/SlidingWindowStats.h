@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "CircularBuffer.h"
+
+// CircularBuffer 위에 얹는 선택적 통계 계층
+// push_back/overwrite/pop_front마다 O(1)(분할 상환)로 갱신:
+// - 합계, 평균, 분산: Welford 방식 (추가/제거 모두 지원)
+// - 최솟값, 최댓값: monotonic deque (같은 용량의 CircularBuffer로 구현)
+// 전체 버퍼를 매번 max_element/accumulate로 훑지 않아도 됨
+template <typename T, size_t N = dynamic_capacity>
+class SlidingWindowStats {
+    static_assert(std::is_arithmetic_v<T>, "SlidingWindowStats는 산술 타입만 지원합니다");
+
+public:
+    // 정수는 정확한 합계를 위해 정수로 누적
+    using sum_type = std::conditional_t<std::is_integral_v<T>, long long, double>;
+
+private:
+    // 윈도우에 들어온 순번(seq)과 값. 순번으로 윈도우 밖으로 밀려났는지 판단
+    struct Entry {
+        size_t seq;
+        T value;
+    };
+
+    CircularBuffer<T, N> window;
+    CircularBuffer<Entry, N> max_queue;  // value 내림차순 유지, front가 최댓값
+    CircularBuffer<Entry, N> min_queue;  // value 오름차순 유지, front가 최솟값
+    size_t next_seq = 0;                 // 다음 push의 순번 (window.front()의 순번 = next_seq - size())
+
+    sum_type m_sum = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;  // 편차 제곱합
+
+    void add(T x) {
+        m_sum += x;
+        const double n = (double)window.size();
+        const double delta = (double)x - m_mean;
+        m_mean += delta / n;
+        m_m2 += delta * ((double)x - m_mean);
+    }
+
+    void remove(T x) {
+        m_sum -= x;
+        const size_t n = window.size();  // 제거 후 개수
+        if (n == 0) {
+            m_mean = 0.0;
+            m_m2 = 0.0;
+            return;
+        }
+        const double delta = (double)x - m_mean;
+        m_mean -= delta / (double)n;
+        m_m2 -= delta * ((double)x - m_mean);
+        if (m_m2 < 0.0) m_m2 = 0.0;  // 부동소수점 오차 보정
+    }
+
+    // 가장 오래된 데이터를 윈도우에서 빼고 통계 갱신
+    void evict_front() {
+        const size_t seq = next_seq - window.size();
+        const T x = window.front();
+        window.pop_front();
+        remove(x);
+        if (!max_queue.empty() && max_queue.front().seq == seq) max_queue.pop_front();
+        if (!min_queue.empty() && min_queue.front().seq == seq) min_queue.pop_front();
+    }
+
+public:
+    template <size_t M = N, std::enable_if_t<M == dynamic_capacity, int> = 0>
+    explicit SlidingWindowStats(size_t capacity)
+        : window(capacity), max_queue(window.capacity()), min_queue(window.capacity()) {}
+
+    template <size_t M = N, std::enable_if_t<M != dynamic_capacity, int> = 0>
+    SlidingWindowStats() {}
+
+    size_t size() const { return window.size(); }
+    size_t capacity() const { return window.capacity(); }
+    bool empty() const { return window.empty(); }
+
+    // 윈도우 내용 (순회/STL 알고리즘용, 읽기 전용)
+    const CircularBuffer<T, N>& data() const { return window; }
+
+    // 가득 차면 가장 오래된 데이터를 덮어씀 (CircularBuffer::push_back과 동일)
+    void push_back(T x) {
+        if (window.size() == window.capacity()) evict_front();
+
+        window.push_back(x);
+        add(x);
+
+        while (!max_queue.empty() && max_queue.back().value <= x) max_queue.pop_back();
+        max_queue.push_back(Entry{next_seq, x});
+        while (!min_queue.empty() && min_queue.back().value >= x) min_queue.pop_back();
+        min_queue.push_back(Entry{next_seq, x});
+
+        next_seq++;
+    }
+
+    void pop_front() {
+        if (empty()) return;
+        evict_front();
+    }
+
+    void clear() {
+        window.clear();
+        max_queue.clear();
+        min_queue.clear();
+        m_sum = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+    }
+
+    // 아래 값은 비어 있지 않을 때만 의미 있음
+    sum_type sum() const { return m_sum; }
+    double mean() const { return m_mean; }
+    double variance() const { return empty() ? 0.0 : m_m2 / (double)size(); }               // 모분산
+    double sample_variance() const { return size() < 2 ? 0.0 : m_m2 / (double)(size() - 1); }  // 표본분산
+    double stddev() const { return std::sqrt(variance()); }
+    T min() const { return min_queue.front().value; }
+    T max() const { return max_queue.front().value; }
+
+    // 추가/제거가 오래 반복되면 평균/분산에 부동소수점 오차가 누적되므로 필요 시 전체 재계산 (O(n))
+    void resync() {
+        m_sum = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+        size_t n = 0;
+        for (const T& x : window) {
+            m_sum += x;
+            n++;
+            const double delta = (double)x - m_mean;
+            m_mean += delta / (double)n;
+            m_m2 += delta * ((double)x - m_mean);
+        }
+    }
+};
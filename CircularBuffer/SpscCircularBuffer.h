@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "CircularBuffer.h"
+#include "WaitGate.h"
+
+// 버퍼가 가득 찼을 때의 동작
+enum class OverflowPolicy {
+    Reject,    // try_push 실패 반환 (데이터 유실 없음)
+    Overwrite  // 가장 오래된 데이터를 덮어씀 (CircularBuffer::push_back과 동일)
+};
+
+// 단일 생산자 / 단일 소비자 전용 lock-free 원형 버퍼
+// - try_push는 생산자 스레드 하나, try_pop은 소비자 스레드 하나에서만 호출해야 함
+// - head(소비자 소유)와 tail(생산자 소유)은 서로 다른 캐시 라인에 배치
+// - head/tail은 단조 증가 카운터이며 실제 슬롯은 SlotIndexer로 구함
+// - ConsumerWait::Blocking이면 wait_pop/wait_pop_n으로 데이터를 기다릴 수 있음
+template <typename T, OverflowPolicy Policy = OverflowPolicy::Reject, ConsumerWait Wait = ConsumerWait::None>
+class SpscCircularBuffer {
+    // Overwrite 모드에서는 소비자가 읽는 도중 생산자가 같은 슬롯을 덮어쓸 수 있으므로
+    // 복사 후 head CAS로 검증하는 방식(seqlock)을 사용 -> 찢어진 값을 버려도 안전한 타입만 허용
+    static_assert(Policy != OverflowPolicy::Overwrite || std::is_trivially_copyable<T>::value,
+                  "OverflowPolicy::Overwrite는 trivially copyable 타입만 지원합니다");
+
+private:
+    using index_type = size_t;
+    using clock = std::chrono::steady_clock;
+    static constexpr size_t line = circular_buffer_detail::cache_line_size;
+    struct NoGate {};
+
+    // 생성 후 변하지 않는 값 (양쪽 스레드가 읽기만 함)
+    circular_buffer_detail::SlotIndexer index;
+    size_t m_capacity;
+    std::unique_ptr<T[]> buffer;
+
+    // 소비자 측: 다음에 꺼낼 위치 + 마지막으로 관찰한 tail
+    alignas(line) std::atomic<index_type> head{0};
+    index_type cached_tail = 0;
+
+    // 생산자 측: 다음에 쓸 위치 + 마지막으로 관찰한 head
+    alignas(line) std::atomic<index_type> tail{0};
+    index_type cached_head = 0;
+
+    // ConsumerWait::Blocking일 때만 실제 관문을 둠 (None이면 크기 0)
+    alignas(line) [[no_unique_address]]
+    std::conditional_t<Wait == ConsumerWait::Blocking, circular_buffer_detail::WaitGate, NoGate> gate;
+
+    size_t wait_pop_n_until(T* out, size_t n, clock::time_point deadline) {
+        static_assert(Wait == ConsumerWait::Blocking, "wait_pop은 ConsumerWait::Blocking에서만 사용할 수 있습니다");
+        n = std::min(n, m_capacity);
+        gate.wait_until([&] { return size() >= n; }, n, deadline);
+        size_t popped = 0;
+        while (popped < n && try_pop(out[popped])) popped++;
+        return popped;
+    }
+
+    template <typename Rep, typename Period>
+    static clock::time_point deadline_after(std::chrono::duration<Rep, Period> timeout) {
+        return clock::now() + std::chrono::ceil<clock::duration>(timeout);
+    }
+
+public:
+    explicit SpscCircularBuffer(size_t capacity, CapacityPolicy policy = CapacityPolicy::Exact)
+        : index(capacity, policy), m_capacity(index.capacity()), buffer(new T[m_capacity]) {}
+
+    SpscCircularBuffer(const SpscCircularBuffer&) = delete;
+    SpscCircularBuffer& operator=(const SpscCircularBuffer&) = delete;
+
+    size_t capacity() const { return m_capacity; }
+
+    // 다른 스레드가 동시에 수정 중일 수 있으므로 근사값
+    size_t size() const {
+        const index_type h = head.load(std::memory_order_acquire);
+        const index_type t = tail.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    // 생산자 전용. 블로킹하지 않음
+    // Reject: 가득 차면 false, Overwrite: 가장 오래된 데이터를 버리고 항상 true
+    bool try_push(const T& item) {
+        const index_type t = tail.load(std::memory_order_relaxed);
+        if (t - cached_head == m_capacity) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head == m_capacity) {
+                if constexpr (Policy == OverflowPolicy::Reject) {
+                    return false;
+                } else {
+                    // 가장 오래된 데이터 폐기. 실패했다면 소비자가 먼저 꺼낸 것이므로 자리가 생김
+                    index_type h = cached_head;
+                    if (head.compare_exchange_strong(h, h + 1, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+                        h = h + 1;
+                    }
+                    cached_head = h;
+                }
+            }
+        }
+        buffer[index(t)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        if constexpr (Wait == ConsumerWait::Blocking) {
+            gate.notify([&] { return t + 1 - cached_head; });
+        }
+        return true;
+    }
+
+    // 소비자 전용. 블로킹하지 않음. 비어 있으면 false
+    bool try_pop(T& out) {
+        if constexpr (Policy == OverflowPolicy::Reject) {
+            const index_type h = head.load(std::memory_order_relaxed);
+            if (h == cached_tail) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (h == cached_tail) return false;
+            }
+            out = std::move(buffer[index(h)]);
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        } else {
+            // 생산자가 head를 밀어낼 수 있으므로 복사 후 CAS로 슬롯이 유효했는지 확인
+            // (head가 생산자에 의해 cached_tail보다 앞서 있을 수 있으므로 >= 비교)
+            index_type h = head.load(std::memory_order_acquire);
+            for (;;) {
+                if (h >= cached_tail) {
+                    cached_tail = tail.load(std::memory_order_acquire);
+                    if (h >= cached_tail) return false;
+                }
+                T value = buffer[index(h)];
+                if (head.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                    out = value;
+                    return true;
+                }
+            }
+        }
+    }
+
+    // 소비자 전용 (ConsumerWait::Blocking). 데이터가 생길 때까지 대기 후 하나를 꺼냄
+    bool wait_pop(T& out) { return wait_pop_n_until(&out, 1, clock::time_point::max()) == 1; }
+
+    // timeout 안에 데이터가 없으면 false
+    template <typename Rep, typename Period>
+    bool wait_pop(T& out, std::chrono::duration<Rep, Period> timeout) {
+        return wait_pop_n_until(&out, 1, deadline_after(timeout)) == 1;
+    }
+
+    // n개(capacity를 넘으면 capacity개)가 쌓일 때까지 대기한 뒤 out에 n개를 꺼냄
+    // 생산자는 n개가 쌓였을 때만 깨우므로 소비자 wakeup이 n개 단위로 묶임
+    size_t wait_pop_n(T* out, size_t n) { return wait_pop_n_until(out, n, clock::time_point::max()); }
+
+    // timeout이 지나면 그때까지 쌓인 만큼(0 ~ n-1개)만 꺼냄. 꺼낸 개수 반환
+    template <typename Rep, typename Period>
+    size_t wait_pop_n(T* out, size_t n, std::chrono::duration<Rep, Period> timeout) {
+        return wait_pop_n_until(out, n, deadline_after(timeout));
+    }
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "CircularBuffer.h"
+#include "CircularBufferSimd.h"
+
+// 다중 해상도 보존용 계층 버퍼 (ring-of-rings)
+// - 원본 샘플은 raw 링에 두고, raw 링이 가장 오래된 샘플을 덮어쓸 때 그 샘플을
+//   첫 번째 tier의 버킷(min/max/sum/count)으로 접어 넣음. 각 tier도 가득 차면 다음 tier로 접음
+//   예) 1kHz 샘플: raw 1초 -> 1초 버킷 60개 -> 1분 버킷 60개 -> 1시간 버킷 168개
+// - 각 샘플은 정확히 한 tier에만 있으므로 메모리는 capacity 합계로 고정
+// - 샘플 위치는 push 순번(seq)으로 표현. tier j 버킷은 seq가 버킷 크기의 배수에서 시작하도록 정렬됨
+// - 질의는 구간이 걸친 tier마다 그 tier의 데이터를 그대로 사용 (raw 구간은 SIMD 커널로 집계)
+template <typename T>
+class TieredCircularBuffer {
+    static_assert(std::is_arithmetic_v<T>, "TieredCircularBuffer는 산술 타입만 지원합니다");
+
+public:
+    using sum_type = circular_buffer_simd::accum_type<T>;
+
+    // tier 하나의 설정: 바로 아래 단계 factor개를 버킷 하나로 접고, 버킷을 capacity개 보관
+    struct TierSpec {
+        size_t factor;
+        size_t capacity;
+    };
+
+    // 버킷 / 질의 결과 요약. count == 0이면 min/max는 의미 없음
+    struct Summary {
+        T min{};
+        T max{};
+        sum_type sum = 0;
+        std::uint64_t count = 0;
+
+        double mean() const { return count == 0 ? 0.0 : (double)sum / (double)count; }
+
+        void add(T x) {
+            if (count == 0 || x < min) min = x;
+            if (count == 0 || x > max) max = x;
+            sum += x;
+            count++;
+        }
+        void merge(const Summary& other) {
+            if (other.count == 0) return;
+            if (count == 0 || other.min < min) min = other.min;
+            if (count == 0 || other.max > max) max = other.max;
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+    // 질의 결과: 요청 구간을 덮는 데 실제로 사용한 seq 범위 [first, last)도 함께 반환
+    // (오래된 구간은 버킷 단위로만 알 수 있으므로 요청보다 넓어질 수 있음)
+    struct QueryResult {
+        Summary summary;
+        std::uint64_t first = 0;
+        std::uint64_t last = 0;
+    };
+
+private:
+    struct Tier {
+        std::uint64_t span;            // 버킷 하나가 덮는 샘플 수
+        size_t factor;                 // 아래 단계 몇 개를 접는지
+        CircularBuffer<Summary> ring;  // 완성된 버킷
+        std::uint64_t begin = 0;       // ring.front()의 시작 seq
+        Summary pending;               // 아직 채워지는 중인 버킷
+        size_t pending_units = 0;      // pending에 접힌 아래 단계 개수
+
+        Tier(std::uint64_t span, size_t factor, size_t capacity) : span(span), factor(factor), ring(capacity) {}
+
+        std::uint64_t pending_begin() const { return begin + ring.size() * span; }
+    };
+
+    CircularBuffer<T> raw;
+    std::deque<Tier> tiers;  // 0번이 가장 세밀함 (CircularBuffer는 이동 불가이므로 재배치 없는 deque)
+    std::uint64_t next_seq = 0;
+
+    // tier j에 아래 단계 요약 하나를 접어 넣음. 버킷이 완성되면 ring에 추가하고,
+    // ring이 가득 차 있으면 가장 오래된 버킷을 먼저 다음 tier로 넘김
+    void fold(size_t j, const Summary& s) {
+        Tier& tier = tiers[j];
+        tier.pending.merge(s);
+        if (++tier.pending_units < tier.factor) return;
+
+        if (tier.ring.size() == tier.ring.capacity()) {
+            if (j + 1 < tiers.size()) fold(j + 1, tier.ring.front());
+            tier.ring.pop_front();
+            tier.begin += tier.span;
+        }
+        tier.ring.push_back(tier.pending);
+        tier.pending = Summary{};
+        tier.pending_units = 0;
+    }
+
+    // raw 링에서 [first, last) 집계 (두 연속 구간에 SIMD 커널 적용)
+    void query_raw(std::uint64_t first, std::uint64_t last, QueryResult& out) const {
+        const std::uint64_t raw_begin = next_seq - raw.size();
+        first = std::max(first, raw_begin);
+        if (first >= last) return;
+        const size_t from = (size_t)(first - raw_begin);
+        const size_t n = (size_t)(last - first);
+
+        const auto seg = raw.segments();
+        std::span<const T> parts[2];
+        if (from < seg[0].size()) {
+            parts[0] = seg[0].subspan(from, std::min(n, seg[0].size() - from));
+            parts[1] = seg[1].first(n - parts[0].size());
+        } else {
+            parts[0] = seg[1].subspan(from - seg[0].size(), n);
+        }
+        for (const auto& p : parts) {
+            if (p.empty()) continue;
+            Summary s;
+            s.min = circular_buffer_simd::min<T>(p);
+            s.max = circular_buffer_simd::max<T>(p);
+            s.sum = circular_buffer_simd::sum<T>(p);
+            s.count = p.size();
+            out.summary.merge(s);
+        }
+        extend(out, first, last);
+    }
+
+    // tier 하나에서 [first, last)와 겹치는 버킷(pending 포함)을 통째로 합침
+    void query_tier(const Tier& tier, std::uint64_t first, std::uint64_t last, QueryResult& out) const {
+        if (!tier.ring.empty() && first < tier.pending_begin() && last > tier.begin) {
+            const std::uint64_t lo = std::max(first, tier.begin);
+            const std::uint64_t hi = std::min(last, tier.pending_begin());
+            const size_t i0 = (size_t)((lo - tier.begin) / tier.span);
+            const size_t i1 = (size_t)((hi - tier.begin + tier.span - 1) / tier.span);
+            for (size_t i = i0; i < i1; ++i) out.summary.merge(tier.ring[i]);
+            extend(out, tier.begin + i0 * tier.span, tier.begin + i1 * tier.span);
+        }
+        if (tier.pending_units != 0) {
+            const std::uint64_t pb = tier.pending_begin();
+            const std::uint64_t pe = pb + tier.pending.count;
+            if (first < pe && last > pb) {
+                out.summary.merge(tier.pending);
+                extend(out, pb, pe);
+            }
+        }
+    }
+
+    static void extend(QueryResult& out, std::uint64_t first, std::uint64_t last) {
+        if (out.first == out.last) {
+            out.first = first;
+            out.last = last;
+            return;
+        }
+        out.first = std::min(out.first, first);
+        out.last = std::max(out.last, last);
+    }
+
+public:
+    // raw_capacity: 원본 샘플 보관 개수. specs: 세밀한 tier부터 순서대로
+    TieredCircularBuffer(size_t raw_capacity, std::initializer_list<TierSpec> specs) : raw(raw_capacity) {
+        if (raw_capacity == 0) throw std::invalid_argument("raw 용량은 0보다 커야 합니다");
+        std::uint64_t span = 1;
+        for (const TierSpec& spec : specs) {
+            if (spec.factor == 0 || spec.capacity == 0)
+                throw std::invalid_argument("tier의 factor와 capacity는 0보다 커야 합니다");
+            span *= spec.factor;
+            tiers.emplace_back(span, spec.factor, spec.capacity);
+        }
+    }
+
+    // 가장 오래된 raw 샘플은 버리지 않고 첫 tier로 접힘 (tier가 없으면 버림)
+    void push_back(T x) {
+        if (raw.size() == raw.capacity() && !tiers.empty()) {
+            Summary s;
+            s.add(raw.front());
+            fold(0, s);
+        }
+        raw.push_back(x);
+        next_seq++;
+    }
+
+    // 지금까지 push된 개수 (= 다음 샘플의 seq)
+    std::uint64_t total_pushed() const { return next_seq; }
+
+    // 아직 어떤 tier에든 남아 있는 가장 오래된 seq
+    std::uint64_t oldest_seq() const {
+        for (size_t j = tiers.size(); j-- > 0;) {
+            const Tier& tier = tiers[j];
+            if (!tier.ring.empty()) return tier.begin;
+            if (tier.pending_units != 0) return tier.pending_begin();
+        }
+        return next_seq - raw.size();
+    }
+
+    size_t tier_count() const { return tiers.size(); }
+    const CircularBuffer<T>& raw_samples() const { return raw; }
+    const CircularBuffer<Summary>& tier(size_t j) const { return tiers[j].ring; }
+    std::uint64_t tier_span(size_t j) const { return tiers[j].span; }
+
+    // seq 구간 [first, last) 요약. 각 부분은 그 구간을 보관 중인 tier에서 바로 집계
+    // (raw 구간은 샘플 단위로 정확하고, 더 오래된 구간은 버킷 경계까지 넓어짐)
+    QueryResult query(std::uint64_t first, std::uint64_t last) const {
+        QueryResult out;
+        last = std::min(last, next_seq);
+        first = std::max(first, oldest_seq());
+        if (first >= last) return out;
+        for (size_t j = tiers.size(); j-- > 0;) query_tier(tiers[j], first, last, out);
+        query_raw(first, last, out);
+        return out;
+    }
+
+    // 최근 n개 샘플 요약
+    QueryResult query_last(std::uint64_t n) const {
+        return query(next_seq > n ? next_seq - n : 0, next_seq);
+    }
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// lock-free 버퍼에서 소비자가 데이터를 기다리는 방식
+enum class ConsumerWait {
+    None,     // try_pop 폴링만 사용 (생산자 추가 비용 없음)
+    Blocking  // wait_pop/wait_pop_n 사용 가능. 생산자는 push마다 fence 1회, 실제로 잠든 소비자가 있을 때만 깨움
+};
+
+namespace circular_buffer_detail {
+
+    inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // 소비자 대기/생산자 깨우기 관문
+    // - 소비자: 잠깐 spin 후 futex(Linux) / condition_variable(그 외)에 잠듦
+    // - 생산자: 잠든 소비자가 없으면 원자 변수 읽기 한 번으로 끝 (시스템 콜 없음)
+    // - 소비자가 "n개 이상"을 기다리면 생산자는 n개가 쌓였을 때만 깨움 (배치 wakeup)
+    //   n은 소비자 하나 기준이므로, 소비자가 여럿이면 n = 1로 기다린 뒤 직접 개수를 재확인
+    class WaitGate {
+    private:
+        static constexpr std::uint32_t min_spin = 16;
+        static constexpr std::uint32_t max_spin = 4096;
+
+        std::atomic<std::uint32_t> epoch{0};         // 깨울 때마다 증가 (futex 대상)
+        std::atomic<std::uint32_t> waiters{0};       // 잠들었거나 잠들려는 소비자 수
+        std::atomic<std::size_t> wanted{1};          // 잠든 소비자가 기다리는 개수
+        std::atomic<std::uint32_t> spin_limit{256};  // 최근 spin 성공 여부에 따라 조정
+#if !defined(__linux__)
+        std::mutex mutex;
+        std::condition_variable cv;
+#endif
+
+        using clock = std::chrono::steady_clock;
+
+        // epoch가 seen에서 바뀌거나 deadline까지 잠듦 (spurious wakeup 허용)
+        void park(std::uint32_t seen, clock::time_point deadline) {
+#if defined(__linux__)
+            if (deadline == clock::time_point::max()) {
+                syscall(SYS_futex, &epoch, FUTEX_WAIT_PRIVATE, seen, nullptr, nullptr, 0);
+                return;
+            }
+            const auto left = deadline - clock::now();
+            if (left <= clock::duration::zero()) return;
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+            timespec ts;
+            ts.tv_sec = (time_t)(ns / 1000000000);
+            ts.tv_nsec = (long)(ns % 1000000000);
+            syscall(SYS_futex, &epoch, FUTEX_WAIT_PRIVATE, seen, &ts, nullptr, 0);
+#else
+            std::unique_lock<std::mutex> lock(mutex);
+            auto changed = [&] { return epoch.load(std::memory_order_acquire) != seen; };
+            if (deadline == clock::time_point::max()) cv.wait(lock, changed);
+            else cv.wait_until(lock, deadline, changed);
+#endif
+        }
+
+        void wake_all() {
+#if defined(__linux__)
+            epoch.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, &epoch, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                epoch.fetch_add(1, std::memory_order_release);
+            }
+            cv.notify_all();
+#endif
+        }
+
+    public:
+        // 소비자: ready()가 참이 되거나 deadline까지 대기. 준비되었으면 true
+        template <typename Ready>
+        bool wait_until(Ready ready, std::size_t n, clock::time_point deadline) {
+            // 1) 짧은 spin: 곧 도착할 데이터는 잠들지 않고 받음
+            const std::uint32_t limit = spin_limit.load(std::memory_order_relaxed);
+            for (std::uint32_t i = 0; i < limit; ++i) {
+                if (ready()) {
+                    if (limit < max_spin) spin_limit.store(limit * 2, std::memory_order_relaxed);
+                    return true;
+                }
+                cpu_relax();
+            }
+            if (limit > min_spin) spin_limit.store(limit / 2, std::memory_order_relaxed);
+
+            // 2) 잠들기: 대기자 등록 -> 조건 재확인 -> epoch가 바뀌지 않았으면 잠듦
+            for (;;) {
+                waiters.fetch_add(1, std::memory_order_seq_cst);
+                wanted.store(n, std::memory_order_relaxed);
+                const std::uint32_t seen = epoch.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);  // notify()의 fence와 짝
+
+                if (ready()) {
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+                if (clock::now() >= deadline) {
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return ready();
+                }
+                park(seen, deadline);
+                waiters.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        // 생산자: 데이터를 공개(release store)한 직후 호출
+        // available()은 잠든 소비자가 있을 때만 호출되며 현재 개수(근사값 가능)를 반환
+        template <typename Available>
+        void notify(Available available) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);  // 공개한 데이터와 waiters 읽기 순서 보장
+            if (waiters.load(std::memory_order_relaxed) == 0) return;
+            if (available() < wanted.load(std::memory_order_relaxed)) return;
+            wake_all();
+        }
+    };
+}
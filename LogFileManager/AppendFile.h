@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace log_file_manager_detail {
+
+    // 추가 전용 파일 + 사용자 공간 버퍼
+    // - append()는 버퍼에만 쌓고, flush()가 write 시스템 콜로 한 번에 내보냄
+    // - sync()는 디스크까지 기록 (fdatasync, Windows는 _commit)
+    // - preallocate(n)이면 파일 끝 뒤로 n바이트씩 미리 할당 (Linux fallocate KEEP_SIZE: 크기는 그대로라 읽기에 영향 없음)
+    //   append마다 블록 할당 메타데이터를 갱신하지 않게 하고, 닫을 때 쓰지 않은 부분은 돌려줌
+    // std::fstream은 파일 디스크립터를 노출하지 않아 fsync 계열을 호출할 수 없으므로 직접 관리
+    class AppendFile {
+    private:
+        int fd = -1;
+        std::string buffer;
+        std::uint64_t preallocateBytes = 0;
+        std::uint64_t size = 0;       // 이 객체가 아는 파일 크기 (preallocate를 켠 경우만 추적)
+        std::uint64_t allocated = 0;  // 미리 할당한 끝 위치
+#if defined(_WIN32)
+        HANDLE overlapped = INVALID_HANDLE_VALUE;  // IoBatch용 FILE_FLAG_OVERLAPPED 핸들 (처음 쓸 때 생성)
+#endif
+
+        static int openAppend(const std::string& path) {
+#if defined(_WIN32)
+            int handle = -1;
+            _sopen_s(&handle, path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _SH_DENYNO,
+                     _S_IREAD | _S_IWRITE);
+            return handle;
+#else
+            return ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#endif
+        }
+
+    public:
+        AppendFile() = default;
+        explicit AppendFile(const std::string& path) : fd(openAppend(path)) {}
+
+        AppendFile(const AppendFile&) = delete;
+        AppendFile& operator=(const AppendFile&) = delete;
+
+        ~AppendFile() { close(); }
+
+        // 기존 파일을 닫고 path를 다시 염
+        void open(const std::string& path) {
+            close();
+            fd = openAppend(path);
+            if (preallocateBytes != 0) preallocate(preallocateBytes);
+        }
+
+        bool is_open() const { return fd >= 0; }
+        size_t buffered() const { return buffer.size(); }
+
+        void append(std::string_view text) { buffer.append(text); }
+
+        int descriptor() const { return fd; }
+        std::string_view pending() const { return buffer; }
+
+        // 쓰기 버퍼(capacity 포함)를 내줌/받음. 닫은 파일의 버퍼를 다른 파일이 재사용 (비어 있을 때만 받음)
+        std::string releaseBuffer() {
+            std::string released;
+            released.swap(buffer);
+            released.clear();
+            return released;
+        }
+        void adoptBuffer(std::string&& reused) {
+            if (!buffer.empty() || reused.capacity() <= buffer.capacity()) return;
+            buffer.swap(reused);
+            buffer.clear();
+        }
+
+        // 버퍼 앞의 n바이트를 기록했음 (IoBatch가 직접 write한 뒤 호출)
+        void consume(size_t n) {
+            if (n >= buffer.size()) buffer.clear();
+            else buffer.erase(0, n);
+        }
+
+        void preallocate(std::uint64_t bytes) {
+            preallocateBytes = bytes;
+#if defined(__linux__)
+            struct stat st;
+            if (bytes != 0 && fd >= 0 && ::fstat(fd, &st) == 0) size = allocated = (std::uint64_t)st.st_size;
+#endif
+        }
+
+        // 곧 n바이트를 기록할 예정 (미리 할당한 범위를 넘으면 preallocateBytes만큼 더 할당)
+        void reserve(size_t n) {
+#if defined(__linux__)
+            if (preallocateBytes == 0) return;
+            if (size + n > allocated) {
+                const std::uint64_t length = std::max<std::uint64_t>(preallocateBytes, size + n - allocated);
+                if (::fallocate(fd, FALLOC_FL_KEEP_SIZE, (off_t)allocated, (off_t)length) == 0) allocated += length;
+                else preallocateBytes = 0;  // 지원하지 않는 파일 시스템
+            }
+            size += n;
+#else
+            (void)n;
+#endif
+        }
+
+#if defined(_WIN32)
+        HANDLE overlappedHandle() {
+            if (overlapped == INVALID_HANDLE_VALUE && fd >= 0) {
+                overlapped = ReOpenFile((HANDLE)_get_osfhandle(fd), GENERIC_WRITE,
+                                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, FILE_FLAG_OVERLAPPED);
+            }
+            return overlapped;
+        }
+#endif
+
+        // 버퍼 내용을 모두 기록. 실패 시 false (기록하지 못한 내용은 버림)
+        bool flush() {
+            reserve(buffer.size());
+            const char* p = buffer.data();
+            size_t left = buffer.size();
+            bool ok = true;
+            while (left > 0) {
+#if defined(_WIN32)
+                const int n = _write(fd, p, (unsigned)(left > 0x40000000 ? 0x40000000 : left));
+#else
+                const ssize_t n = ::write(fd, p, left);
+#endif
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    ok = false;
+                    break;
+                }
+                p += n;
+                left -= (size_t)n;
+            }
+            buffer.clear();  // capacity는 유지 -> 다음 배치에서 재할당 없음
+            return ok;
+        }
+
+        // 이미 write한 내용을 디스크까지 기록 (메타데이터는 필요한 것만)
+        bool sync() {
+#if defined(_WIN32)
+            return _commit(fd) == 0;
+#elif defined(__APPLE__)
+            return ::fsync(fd) == 0;
+#else
+            return ::fdatasync(fd) == 0;
+#endif
+        }
+
+        void close() {
+            if (fd < 0) return;
+            flush();
+#if defined(_WIN32)
+            if (overlapped != INVALID_HANDLE_VALUE) CloseHandle(overlapped);
+            overlapped = INVALID_HANDLE_VALUE;
+            _close(fd);
+#else
+#if defined(__linux__)
+            // 미리 할당했지만 쓰지 않은 블록 반환 (크기는 그대로이므로 내용에는 영향 없음)
+            struct stat st;
+            if (allocated > size && ::fstat(fd, &st) == 0 && (std::uint64_t)st.st_size < allocated) {
+                const int truncated = ::ftruncate(fd, st.st_size);
+                (void)truncated;
+            }
+#endif
+            ::close(fd);
+#endif
+            fd = -1;
+            size = allocated = 0;
+        }
+    };
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "LogFormat.h"
+#include "LogReader.h"
+#include "LogTimestamp.h"
+
+// 바이너리 로그 형식 (openBinaryLog로 연 파일)
+// 줄마다 텍스트로 변환하지 않고 형식 ID + 원시 시각 + 인자 원시 값만 기록하며, decodeBinaryLog가 텍스트로 되돌림
+//   파일 = "BLOG0001" + 블록...
+//   'S'                                          세션 시작 (파일을 열 때마다. 형식 ID 사전을 비움)
+//   'F' id(u32) n(u8) 타입코드[n] len(u32) 형식  형식 정의 (이 세션에서 id가 처음 쓰일 때 한 번)
+//   'R' id(u32) ns(i64) len(u32) 인자[len]       레코드 (ns: epoch 나노초, 인자는 LogFormat.h의 pack 형식)
+// 정수는 호스트 바이트 순서
+namespace log_file_manager_detail {
+
+    inline constexpr char binaryMagic[8] = {'B', 'L', 'O', 'G', '0', '0', '0', '1'};
+    inline constexpr char binarySession = 'S';
+    inline constexpr char binaryFormat = 'F';
+    inline constexpr char binaryRecord = 'R';
+    inline constexpr size_t binaryRecordHeader = 1 + 4 + 8 + 4;
+
+    enum class ArgCode : std::uint8_t {
+        Bool = 1, Char, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double, LongDouble, String
+    };
+
+    // LogArg로 정규화된 타입의 코드
+    template <typename T>
+    constexpr ArgCode argCode() {
+        if constexpr (std::is_same_v<T, bool>) return ArgCode::Bool;
+        else if constexpr (std::is_same_v<T, char>) return ArgCode::Char;
+        else if constexpr (std::is_same_v<T, std::string_view>) return ArgCode::String;
+        else if constexpr (std::is_same_v<T, float>) return ArgCode::Float;
+        else if constexpr (std::is_same_v<T, double>) return ArgCode::Double;
+        else if constexpr (std::is_same_v<T, long double>) return ArgCode::LongDouble;
+        else if constexpr (std::is_signed_v<T>) {
+            return sizeof(T) == 1 ? ArgCode::Int8 : sizeof(T) == 2 ? ArgCode::Int16 : sizeof(T) == 4 ? ArgCode::Int32 : ArgCode::Int64;
+        } else {
+            return sizeof(T) == 1 ? ArgCode::UInt8 : sizeof(T) == 2 ? ArgCode::UInt16 : sizeof(T) == 4 ? ArgCode::UInt32 : ArgCode::UInt64;
+        }
+    }
+
+    // 프로세스 전체의 형식 사전 (형식 문자열 + 인자 타입 -> ID). binaryFormatId가 스레드별로 결과를 기억
+    class BinaryFormatRegistry {
+    private:
+        struct Entry {
+            std::string format;
+            std::string codes;
+        };
+
+        std::mutex mutex;
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, std::uint32_t> ids;  // codes + '\0' + format
+
+    public:
+        static BinaryFormatRegistry& instance() {
+            static BinaryFormatRegistry registry;
+            return registry;
+        }
+
+        std::uint32_t id(std::string_view format, std::string_view codes) {
+            std::string key;
+            key.reserve(codes.size() + 1 + format.size());
+            key.append(codes).append(1, '\0').append(format);
+            std::lock_guard<std::mutex> lock(mutex);
+            auto [it, inserted] = ids.try_emplace(std::move(key), (std::uint32_t)entries.size());
+            if (inserted) entries.push_back(Entry{std::string(format), std::string(codes)});
+            return it->second;
+        }
+
+        // 'F' 정의 블록
+        std::string definition(std::uint32_t id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const Entry& e = entries.at(id);
+            std::string out(1, binaryFormat);
+            const std::uint8_t n = (std::uint8_t)e.codes.size();
+            const std::uint32_t length = (std::uint32_t)e.format.size();
+            out.append((const char*)&id, sizeof(id));
+            out.append((const char*)&n, sizeof(n));
+            out.append(e.codes);
+            out.append((const char*)&length, sizeof(length));
+            out.append(e.format);
+            return out;
+        }
+    };
+
+    // 스레드별로 호출 위치(형식 문자열 포인터)마다 ID를 기억해 사전 조회를 건너뜀
+    // 같은 인자 타입을 쓰는 호출 위치가 여럿이어도 각자 항목을 가지므로, 잠금은 스레드 x 호출 위치마다 처음 한 번
+    template <typename... Args>
+    std::uint32_t binaryFormatId(std::string_view format) {
+        static_assert(sizeof...(Args) < 256, "인자가 너무 많습니다");
+        struct Cached {
+            size_t size;
+            std::uint32_t id;
+        };
+        thread_local std::unordered_map<const char*, Cached> cache;  // 형식 문자열은 정적 저장소라 포인터가 고정됨
+        auto it = cache.find(format.data());
+        if (it != cache.end() && it->second.size == format.size()) return it->second.id;
+        static constexpr char codes[] = {(char)argCode<Args>()..., '\0'};
+        const std::uint32_t id = BinaryFormatRegistry::instance().id(format, std::string_view(codes, sizeof...(Args)));
+        cache.insert_or_assign(format.data(), Cached{format.size(), id});
+        return id;
+    }
+
+    template <typename... Args>
+    size_t binaryRecordSize(const Args&... args) {
+        return binaryRecordHeader + (size_t(0) + ... + packedSize(args));
+    }
+
+    // out에 binaryRecordSize 바이트 기록
+    template <typename... Args>
+    void packBinaryRecord(char* out, std::uint32_t id, std::int64_t nanoseconds, const Args&... args) {
+        const std::uint32_t length = (std::uint32_t)(size_t(0) + ... + packedSize(args));
+        *out++ = binaryRecord;
+        out = pack(out, id);
+        out = pack(out, nanoseconds);
+        out = pack(out, length);
+        ((out = pack(out, args)), ...);
+    }
+
+    // 파일에서 읽은 레코드용 unpack: [in, end)를 벗어나면 예외 (손상된 파일에서 매핑 밖을 읽지 않도록)
+    template <typename T>
+    const char* unpack(const char* in, const char* end, T& value) {
+        if ((size_t)(end - in) < sizeof(T)) throw std::runtime_error("바이너리 로그 손상: 인자가 레코드 밖으로 넘어감");
+        if constexpr (std::is_same_v<T, bool>) {
+            value = *in != 0;  // 0/1이 아닌 바이트를 bool로 복사하지 않음
+            return in + 1;
+        } else {
+            return unpack(in, value);
+        }
+    }
+    inline const char* unpack(const char* in, const char* end, std::string_view& value) {
+        std::uint32_t size;
+        in = unpack(in, end, size);
+        if ((size_t)(end - in) < size) throw std::runtime_error("바이너리 로그 손상: 인자가 레코드 밖으로 넘어감");
+        value = std::string_view(in, size);
+        return in + size;
+    }
+
+    template <typename T>
+    const char* appendPacked(std::string& out, const char* in, const char* end) {
+        T value;
+        in = unpack(in, end, value);
+        appendArg(out, value);
+        return in;
+    }
+
+    // 타입 코드 하나만큼 [in, end)에서 인자를 읽어 텍스트로 붙임
+    inline const char* appendPackedArg(std::string& out, ArgCode code, const char* in, const char* end) {
+        switch (code) {
+        case ArgCode::Bool: return appendPacked<bool>(out, in, end);
+        case ArgCode::Char: return appendPacked<char>(out, in, end);
+        case ArgCode::Int8: return appendPacked<std::int8_t>(out, in, end);
+        case ArgCode::UInt8: return appendPacked<std::uint8_t>(out, in, end);
+        case ArgCode::Int16: return appendPacked<std::int16_t>(out, in, end);
+        case ArgCode::UInt16: return appendPacked<std::uint16_t>(out, in, end);
+        case ArgCode::Int32: return appendPacked<std::int32_t>(out, in, end);
+        case ArgCode::UInt32: return appendPacked<std::uint32_t>(out, in, end);
+        case ArgCode::Int64: return appendPacked<std::int64_t>(out, in, end);
+        case ArgCode::UInt64: return appendPacked<std::uint64_t>(out, in, end);
+        case ArgCode::Float: return appendPacked<float>(out, in, end);
+        case ArgCode::Double: return appendPacked<double>(out, in, end);
+        case ArgCode::LongDouble: return appendPacked<long double>(out, in, end);
+        case ArgCode::String: return appendPacked<std::string_view>(out, in, end);
+        }
+        throw std::runtime_error("알 수 없는 인자 타입 코드");
+    }
+}
+
+inline bool isBinaryLog(std::string_view data) {
+    return data.size() >= sizeof(log_file_manager_detail::binaryMagic) &&
+           std::memcmp(data.data(), log_file_manager_detail::binaryMagic, sizeof(log_file_manager_detail::binaryMagic)) == 0;
+}
+
+namespace log_file_manager_detail {
+
+    // 마지막으로 완전한 블록의 끝 위치 (기록 중 종료로 잘린 꼬리를 잘라낸 뒤 이어 쓰기 위함)
+    inline size_t binaryValidLength(std::string_view data) {
+        size_t pos = sizeof(binaryMagic);
+        while (pos < data.size()) {
+            const size_t left = data.size() - pos;
+            const char* p = data.data() + pos;
+            size_t block;
+            if (*p == binarySession) {
+                block = 1;
+            } else if (*p == binaryFormat) {
+                if (left < 6) break;
+                const size_t n = (std::uint8_t)p[5];
+                std::uint32_t length;
+                if (left < 6 + n + sizeof(length)) break;
+                std::memcpy(&length, p + 6 + n, sizeof(length));
+                block = 6 + n + sizeof(length) + length;
+            } else if (*p == binaryRecord) {
+                std::uint32_t length;
+                if (left < binaryRecordHeader) break;
+                std::memcpy(&length, p + 13, sizeof(length));
+                block = binaryRecordHeader + length;
+            } else {
+                break;
+            }
+            if (block > left) break;
+            pos += block;
+        }
+        return pos < data.size() ? pos : data.size();
+    }
+}
+
+// 바이너리 로그 내용을 "[YYYY-MM-DD HH:MM:SS] message" 줄로 되돌려 줄마다 callback(std::string_view) 호출
+// 마지막 블록이 잘려 있으면(기록 중 비정상 종료) 거기서 멈춤. 반환값: 변환한 레코드 수
+template <typename Callback>
+std::uint64_t decodeBinaryLog(std::string_view data, Callback&& callback, const TimestampFormat& format = TimestampFormat()) {
+    using namespace log_file_manager_detail;
+    if (!isBinaryLog(data)) {
+        throw std::runtime_error("바이너리 로그 형식이 아닙니다");
+    }
+    struct Definition {
+        std::string_view format;
+        std::string_view codes;
+        bool defined = false;
+    };
+    std::vector<Definition> dictionary;
+    std::string line;
+    std::uint64_t count = 0;
+
+    const char* p = data.data() + sizeof(binaryMagic);
+    const char* end = data.data() + data.size();
+    while (p < end) {
+        const char tag = *p;
+        if (tag == binarySession) {
+            dictionary.clear();
+            ++p;
+        } else if (tag == binaryFormat) {
+            if (end - p < 6) break;
+            std::uint32_t id;
+            const std::uint8_t n = (std::uint8_t)p[5];
+            std::memcpy(&id, p + 1, sizeof(id));
+            if ((size_t)(end - p) < 6 + n + sizeof(std::uint32_t)) break;
+            std::uint32_t length;
+            std::memcpy(&length, p + 6 + n, sizeof(length));
+            const char* text = p + 6 + n + sizeof(length);
+            if ((size_t)(end - text) < length) break;
+            if (dictionary.size() <= id) dictionary.resize((size_t)id + 1);
+            dictionary[id] = Definition{std::string_view(text, length), std::string_view(p + 6, n), true};
+            p = text + length;
+        } else if (tag == binaryRecord) {
+            if ((size_t)(end - p) < binaryRecordHeader) break;
+            std::uint32_t id, length;
+            std::int64_t nanoseconds;
+            std::memcpy(&id, p + 1, sizeof(id));
+            std::memcpy(&nanoseconds, p + 5, sizeof(nanoseconds));
+            std::memcpy(&length, p + 13, sizeof(length));
+            const char* args = p + binaryRecordHeader;
+            if ((size_t)(end - args) < length) break;
+            if (id >= dictionary.size() || !dictionary[id].defined) {
+                throw std::runtime_error("바이너리 로그 손상: 정의되지 않은 형식 ID");
+            }
+            const Definition& def = dictionary[id];
+
+            char timestamp[timestampMaxLength];
+            const auto when = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+            line.assign(timestamp, formatTimestamp(timestamp, format, when));
+            line.push_back(' ');
+            const char* in = args;
+            size_t pos = 0;
+            for (const char code : def.codes) {
+                pos = appendLiteral(line, def.format, pos);
+                in = appendPackedArg(line, (ArgCode)code, in, args + length);
+            }
+            if (in != args + length) {
+                throw std::runtime_error("바이너리 로그 손상: 레코드 길이와 인자 크기가 다름");
+            }
+            appendLiteral(line, def.format, pos);
+            callback(std::string_view(line));
+            count++;
+            p = args + length;
+        } else {
+            throw std::runtime_error("바이너리 로그 손상: 알 수 없는 블록");
+        }
+    }
+    return count;
+}
+
+template <typename Callback>
+std::uint64_t decodeBinaryLogFile(const std::string& path, Callback&& callback,
+                                  const TimestampFormat& format = TimestampFormat()) {
+    log_file_manager_detail::MappedFile file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("파일을 열 수 없습니다: " + path);
+    }
+    return decodeBinaryLog(file.view(), callback, format);
+}
@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "LogBinary.h"
+
+// openBinaryLog로 기록한 바이너리 로그를 텍스트로 변환해 stdout에 출력
+//
+// 사용법: LogDecode [--utc] [--ms|--us] [--iso] <파일>...
+
+int main(int argc, char** argv) {
+    TimestampFormat format;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--utc") == 0) format.zone = TimestampZone::Utc;
+        else if (std::strcmp(argv[i], "--ms") == 0) format.precision = TimestampPrecision::Milliseconds;
+        else if (std::strcmp(argv[i], "--us") == 0) format.precision = TimestampPrecision::Microseconds;
+        else if (std::strcmp(argv[i], "--iso") == 0) format.style = TimestampStyle::Iso8601;
+        else if (argv[i][0] != '-') files.push_back(argv[i]);
+        else {
+            files.clear();  // 알 수 없는 옵션
+            break;
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "사용법: " << argv[0] << " [--utc] [--ms|--us] [--iso] <파일>..." << std::endl;
+        return 2;
+    }
+
+    try {
+        for (const std::string& file : files) {
+            decodeBinaryLogFile(file, [](std::string_view line) {
+                std::fwrite(line.data(), 1, line.size(), stdout);
+                std::fputc('\n', stdout);
+            }, format);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "오류: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -10,94 +10,7 @@
 #include <stdexcept>
 #include <thread>
 
-class LogFileManager {
-private:
-    // 파일명과 파일 스트림을 1:1로 매핑하여 관리
-    std::map<std::string, std::unique_ptr<std::fstream>> logFiles;
-
-    // 현재 시간을 [YYYY-MM-DD HH:MM:SS] 형식의 문자열로 생성
-    std::string getCurrentTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto in_time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&in_time_t), "[%Y-%m-%d %H:%M:%S]");
-        return ss.str();
-    }
-
-public:
-    LogFileManager() = default;
-
-    // 복사 금지 (파일 자원 독점 보장)
-    LogFileManager(const LogFileManager&) = delete;
-    LogFileManager& operator=(const LogFileManager&) = delete;
-
-    // 이동 허용 (noexcept를 통한 성능 최적화)
-    LogFileManager(LogFileManager&&) noexcept = default;
-    LogFileManager& operator=(LogFileManager&&) noexcept = default;
-
-    // 1. 로그 파일 오픈
-    void openLogFile(const std::string& filename) {
-        if (logFiles.find(filename) != logFiles.end()) return;
-
-        // 입출력(in/out) 및 추가(app) 모드 동시 사용
-        auto file = std::make_unique<std::fstream>(filename, std::ios::in | std::ios::out | std::ios::app);
-        
-        if (!file->is_open()) {
-            throw std::runtime_error("파일을 열 수 없습니다: " + filename);
-        }
-        logFiles[filename] = std::move(file);
-    }
-
-    // 2. 로그 기록
-    void writeLog(const std::string& filename, const std::string& message) {
-        auto it = logFiles.find(filename);
-        if (it == logFiles.end()) {
-            throw std::runtime_error("열려 있지 않은 파일에 기록 시도: " + filename);
-        }
-
-        // ios::app 모드이므로 쓰기 포인터는 자동으로 마지막에 위치함
-        *(it->second) << getCurrentTimestamp() << " " << message << std::endl;
-
-        if (it->second->fail()) {
-            it->second->clear();
-            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + filename);
-        }
-    }
-
-    // 3. 로그 읽기 (동일한 파일 핸들 사용)
-    std::vector<std::string> readLogs(const std::string& filename) {
-        auto it = logFiles.find(filename);
-        if (it == logFiles.end()) {
-            throw std::runtime_error("열려 있지 않은 파일 읽기 시도: " + filename);
-        }
-
-        auto& file = *(it->second);
-        std::vector<std::string> logs;
-
-        // 포인터 제어: 상태 초기화 후 맨 앞으로 이동
-        file.clear(); 
-        file.seekg(0, std::ios::beg);
-
-        std::string line;
-        while (std::getline(file, line)) {
-            logs.push_back(line);
-        }
-
-        file.clear(); // 다음 작업을 위해 다시 상태 초기화
-        return logs;
-    }
-
-    // 4. 로그 파일 닫기
-    void closeLogFile(const std::string& filename) {
-        auto it = logFiles.find(filename);
-        if (it != logFiles.end()) {
-            it->second->close();
-            logFiles.erase(it); // unique_ptr 소멸 및 맵에서 제거
-        }
-    }
-
-    ~LogFileManager() = default;
-};
+#include "LogFileManager.h"
 
 int main() {
     try {
@@ -122,6 +35,27 @@ int main() {
             // std::cout << log << std::endl;
             printf("errorLogs[%d]= %s\n", i, errorLogs[i].c_str());
         }
+        // 시각 범위 검색: 인덱스가 있어도 없을 때와 같은 줄을 찾아야 함 (to가 초 중간이어도)
+        using namespace std::chrono;
+        while (duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() % 1000 < 600) {
+            std::this_thread::sleep_for(milliseconds(10));  // 초의 뒤쪽에 기록해 to(.500)보다 늦게 기록되도록
+        }
+        manager.openLogFile("search_plain.log");
+        manager.openLogFile("search_indexed.log", FlushPolicy(), 1);
+        const auto written = system_clock::now();
+        manager.writeLog("search_plain.log", "range search check");
+        manager.writeLog("search_indexed.log", "range search check");
+        SearchOptions range;
+        range.from = written - seconds(10);
+        range.to = floor<seconds>(written) + milliseconds(500);
+        const size_t plainHits = manager.search("search_plain.log", "range search check", range).size();
+        const size_t indexedHits = manager.search("search_indexed.log", "range search check", range).size();
+        printf("search hits: plain=%zu indexed=%zu\n", plainHits, indexedHits);
+        if (plainHits != indexedHits) {
+            std::cerr << "인덱스 유무에 따라 검색 결과가 다릅니다" << std::endl;
+            return 1;
+        }
+
         // 만약 열리지 않은 파일을 쓰려고 하면? (에러 테스트용)
         // manager.writeLog("ghost.log", "Catch me if you can");
 
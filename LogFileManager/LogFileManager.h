@@ -0,0 +1,1634 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../CircularBuffer/CircularBuffer.h"
+#include "../CircularBuffer/MpmcCircularBuffer.h"
+#include "AppendFile.h"
+#include "LogBinary.h"
+#include "LogFormat.h"
+#include "LogIndex.h"
+#include "LogIo.h"
+#include "LogLevel.h"
+#include "LogMetrics.h"
+#include "LogReader.h"
+#include "LogRotation.h"
+#include "LogSearch.h"
+#include "LogTimestamp.h"
+
+// 비동기 모드에서 큐가 가득 찼을 때 writeLog의 동작
+enum class BackPressure {
+    Block,     // 자리가 날 때까지 잠들어 대기 (유실 없음. 백그라운드 스레드가 배치를 꺼낸 뒤 깨움)
+    Drop,      // 새 로그를 버리고 droppedCount() 증가
+    Overwrite  // 가장 오래된 대기 로그를 버리고 기록, overwrittenCount() 증가
+};
+
+// 비동기 모드 설정
+struct AsyncOptions {
+    size_t queueCapacity = 8192;  // 대기 가능한 로그 수 (슬롯은 생성 시 모두 할당). 2 이상
+    size_t batchSize = 512;       // 백그라운드 스레드가 한 번에 모아 쓰는 최대 로그 수. 1 이상
+    BackPressure backPressure = BackPressure::Block;
+    bool deferFormatting = false;  // writeLogf 인자를 원시 값으로 큐에 넣고 문자열 변환은 백그라운드 스레드에서 수행
+    IoBackend ioBackend = IoBackend::Auto;  // 커밋할 파일이 여럿이면 write(+fdatasync)를 한 번에 제출
+};
+
+// 파일별 flush(그룹 커밋) 정책. 조건 중 하나라도 만족하면 버퍼를 write로 내보냄 (0은 사용 안 함)
+// 기본값은 한 줄마다 flush (기존 std::endl 동작과 동일)
+struct FlushPolicy {
+    size_t everyRecords = 1;
+    size_t everyBytes = 0;
+    std::chrono::milliseconds everyInterval{0};
+    bool syncOnCommit = false;  // 커밋마다 fdatasync (전원 손실에도 유지)
+    std::uint64_t preallocateBytes = 0;  // 파일 끝 뒤로 이만큼씩 미리 할당 (Linux fallocate, 닫을 때 남은 부분 반환)
+
+    // 매 줄 write + fdatasync (error.log 등)
+    static FlushPolicy durable() { return FlushPolicy{1, 0, std::chrono::milliseconds(0), true}; }
+
+    // 여러 줄을 모아 한 번에 write (debug.log 등). 1MiB씩 미리 할당
+    static FlushPolicy batched(size_t records, size_t bytes = 64 * 1024,
+                               std::chrono::milliseconds interval = std::chrono::milliseconds(200)) {
+        return FlushPolicy{records, bytes, interval, false, 1 << 20};
+    }
+};
+
+// 열린 파일 디스크립터 수 상한 (setFileCache). 파일이 수천 개일 때 fd 한도와 버퍼 메모리를 일정하게 유지
+struct FileCacheOptions {
+    size_t maxOpenFiles = 0;    // 동시에 열어 둘 로그 파일 수 (0: 제한 없음). 인덱스 파일은 로그 파일과 함께 닫힘
+    size_t pooledBuffers = 64;  // 닫은 파일의 쓰기 버퍼를 이만큼까지 보관해 다시 여는 파일이 재사용 (0: 바로 해제)
+};
+
+// fileCacheStats() 결과
+struct FileCacheStats {
+    std::uint64_t hits = 0;               // 열려 있던 파일에 기록
+    std::uint64_t misses = 0;             // 닫혀 있어 다시 연 횟수
+    std::uint64_t evictions = 0;          // 상한을 넘어 닫은 횟수
+    std::uint64_t reopenNanoseconds = 0;  // 다시 여는 데 걸린 시간 합계
+    size_t openFiles = 0;                 // 지금 열려 있는 (캐시가 관리하는) 파일 수
+    size_t pooledBuffers = 0;             // 재사용을 기다리는 쓰기 버퍼 수
+};
+
+// openLogFile이 반환하는 파일 핸들 (슬롯 번호 + 세대). 기록할 때 파일명 조회를 건너뜀
+// 파일을 닫으면 슬롯의 세대가 바뀌므로 이전 핸들은 재사용된 슬롯을 가리키지 않고 예외로 처리됨
+struct LogHandle {
+    std::uint32_t index = UINT32_MAX;
+    std::uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+class LogFileManager {
+private:
+    // 정책과 무관하게 버퍼가 이 크기를 넘으면 커밋 (메모리 상한)
+    static constexpr size_t maxBufferedBytes = 1 << 20;
+
+    // 회전(rename)이 실패한 파일이 다음 회전을 시도하기까지의 간격 (커밋마다 닫고 다시 열지 않도록)
+    static constexpr std::chrono::seconds rotationRetryDelay{5};
+
+    // 바이너리 파일에 writeLog(message)를 기록할 때의 형식
+    static constexpr std::string_view plainFormat = "{}";
+
+    using steady_clock = std::chrono::steady_clock;
+
+    struct DescriptorCache;
+
+    struct LogFile {
+        std::mutex mutex;  // out / 커밋 카운터 보호 (백그라운드 스레드와 flush/readLogs 호출자 사이)
+        const std::string name;
+        log_file_manager_detail::AppendFile out;
+        FlushPolicy policy;
+        size_t uncommittedRecords = 0;
+        steady_clock::time_point lastCommit = steady_clock::now();
+
+        std::unique_ptr<log_file_manager_detail::LineIndex> index;  // openLogFile(..., indexEvery)로 켠 경우만
+
+        // 회전 상태 (rotation.enabled()인 경우만 사용)
+        RotationPolicy rotation;
+        log_file_manager_detail::RotationWorker* rotationWorker = nullptr;
+        TimestampZone zone;
+        std::uint64_t fileBytes = 0;    // 활성 파일에 기록된 크기
+        std::int64_t currentDay = 0;    // 활성 파일이 속한 날짜
+        std::uint64_t nextSegment = 1;  // 다음 회전 세그먼트 번호
+        steady_clock::time_point rotationRetryAt{};  // rename 실패 후 이 시각까지는 회전을 다시 시도하지 않음
+
+        // 바이너리 형식 (openBinaryLog). definedFormats: 이번 세션에서 이미 'F' 정의를 쓴 형식 ID
+        // (기록하는 쪽만 접근: 동기 모드는 mutex 보유 중, 비동기 모드는 백그라운드 스레드)
+        bool binary = false;
+        std::vector<bool> definedFormats;
+
+        // 최근 레코드 캐시 (setTailCapacity로 켠 경우만). tail()이 파일을 읽지 않고 바로 응답
+        // 기록 경로(mutex 보유 중 또는 백그라운드 스레드)와 tail() 사이는 tailMutex로 보호 (커밋 중에도 막히지 않음)
+        std::mutex tailMutex;
+        std::unique_ptr<CircularBuffer<std::string>> recent;
+
+        std::string pending;              // 백그라운드 스레드가 이번 배치에 모은 내용
+        size_t pendingRecords = 0;        // pending에 모은 레코드 수
+        std::vector<log_file_manager_detail::StagedRecord> staged;  // pending에 담긴 레코드의 색인 정보 (백그라운드 스레드 전용)
+        std::atomic<bool> failed{false};  // 백그라운드 기록 실패 (다음 호출에서 예외로 전달)
+
+        // 디스크립터 캐시 (setFileCache 이후 연 파일만). parked/cacheHits는 mutex, 목록 연결은 DescriptorCache::mutex 보호
+        // 닫혀 있는(parked) 파일은 버퍼가 비어 있음: 기록 경로가 버퍼에 쓰기 전에 DescriptorCache::use로 다시 엶
+        DescriptorCache* cache = nullptr;
+        LogFile* lruPrev = nullptr;
+        LogFile* lruNext = nullptr;
+        bool lruLinked = false;
+        bool parked = false;
+        std::atomic<std::uint64_t> touchedAt{0};  // 목록 맨 앞으로 옮긴 시점의 DescriptorCache::clock
+        std::uint64_t cacheHits = 0;
+
+        // metrics() 카운터 (커밋할 때 갱신). metrics: 관리자의 지표 상태 (테이블에 등록한 파일만)
+        log_file_manager_detail::FileCounters counters;
+        log_file_manager_detail::MetricsState* metrics = nullptr;
+
+        LogFile(const std::string& filename, const FlushPolicy& policy, std::uint32_t indexEvery,
+                const RotationPolicy& rotation, log_file_manager_detail::RotationWorker* rotationWorker,
+                TimestampZone zone, size_t tailCapacity = 0)
+            : name(filename), out(filename), policy(policy), rotation(rotation), rotationWorker(rotationWorker), zone(zone) {
+            if (!out.is_open()) return;
+            if (policy.preallocateBytes != 0) out.preallocate(policy.preallocateBytes);
+            if (tailCapacity != 0) {
+                // 기존 파일의 마지막 줄들로 채워 재시작 직후에도 tail()이 비어 있지 않게 함
+                recent = std::make_unique<CircularBuffer<std::string>>(tailCapacity);
+                log_file_manager_detail::MappedFile existing(filename);
+                const std::string_view data = existing.view();
+                for (size_t pos = log_file_manager_detail::tailOffset(data, tailCapacity); pos < data.size();) {
+                    size_t newline = data.find('\n', pos);
+                    if (newline == std::string_view::npos) newline = data.size();
+                    recent->emplace_back(data.substr(pos, newline - pos));
+                    pos = newline + 1;
+                }
+            }
+            if (indexEvery != 0) {
+                index = std::make_unique<log_file_manager_detail::LineIndex>(filename, indexEvery, zone);
+            }
+            if (rotation.enabled()) {
+                namespace fs = std::filesystem;
+                std::error_code ec;
+                fileBytes = fs::file_size(filename, ec);
+                // 기존 파일은 마지막 수정 시각의 날짜에 속한 것으로 봄
+                auto modified = std::chrono::system_clock::now();
+                const auto written = fs::last_write_time(filename, ec);
+                if (!ec && fileBytes != 0) {
+                    modified += std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        written - fs::file_time_type::clock::now());
+                }
+                currentDay = log_file_manager_detail::dayNumber(modified, zone);
+                const auto segments = log_file_manager_detail::listSegments(filename);
+                if (!segments.empty()) nextSegment = segments.back().seq + 1;
+            }
+        }
+
+        ~LogFile() {
+            if (out.is_open()) commit();
+        }
+
+        // 바이너리 형식으로 시작: 빈 파일이면 파일 헤더를, 아니면 잘린 꼬리를 정리한 뒤 세션 블록을 씀
+        void startBinary() {
+            using namespace log_file_manager_detail;
+            {
+                MappedFile existing(name);
+                const std::string_view data = existing.view();
+                if (!data.empty() && !isBinaryLog(data)) {
+                    throw std::runtime_error("바이너리 로그 형식이 아닌 파일입니다: " + name);
+                }
+                if (data.empty()) {
+                    out.append(std::string_view(binaryMagic, sizeof(binaryMagic)));
+                } else if (const size_t valid = binaryValidLength(data); valid != data.size()) {
+                    std::error_code ec;
+                    std::filesystem::resize_file(name, valid, ec);  // O_APPEND이므로 이후 기록은 잘린 끝에 붙음
+                }
+            }
+            binary = true;
+            out.append(std::string_view(&binarySession, 1));
+            out.flush();
+        }
+
+        // 바이너리 레코드 앞에 이 세션에서 처음 쓰이는 형식 정의를 붙임 (sink: AppendFile 또는 pending)
+        template <typename Sink>
+        void appendBinary(std::string_view record, Sink& sink) {
+            std::uint32_t id;
+            std::memcpy(&id, record.data() + 1, sizeof(id));
+            if (id >= definedFormats.size()) definedFormats.resize((size_t)id + 1, false);
+            if (!definedFormats[id]) {
+                sink.append(log_file_manager_detail::BinaryFormatRegistry::instance().definition(id));
+                definedFormats[id] = true;
+            }
+            sink.append(record);
+        }
+
+        // 레코드 하나를 캐시에 추가 ('\n' 제외). 가득 찼으면 가장 오래된 문자열의 버퍼를 재사용
+        template <typename... Parts>
+        void remember(const Parts&... parts) {
+            std::lock_guard<std::mutex> lock(tailMutex);
+            std::string line;
+            if (recent->size() == recent->capacity()) {
+                line = std::move(recent->front());
+                recent->pop_front();
+                line.clear();
+            }
+            (line.append(parts), ...);
+            recent->push_back(std::move(line));
+        }
+
+        // 정책상 지금 커밋해야 하는지 (mutex 보유 상태에서 호출)
+        bool commitDue(steady_clock::time_point now) const {
+            if (uncommittedRecords == 0) return false;
+            if (policy.everyRecords != 0 && uncommittedRecords >= policy.everyRecords) return true;
+            if (policy.everyBytes != 0 && out.buffered() >= policy.everyBytes) return true;
+            if (policy.everyInterval.count() != 0 && now - lastCommit >= policy.everyInterval) return true;
+            return out.buffered() >= maxBufferedBytes;
+        }
+
+        // 시간 조건이 있을 때만 시계를 읽음 (동기 기록 경로)
+        bool commitDueNow() const {
+            return commitDue(policy.everyInterval.count() != 0 ? steady_clock::now() : steady_clock::time_point());
+        }
+
+        // 버퍼를 기록하고 정책(또는 forceSync)에 따라 fdatasync. 실패 시 false (mutex 보유 상태에서 호출)
+        // 회전 조건은 커밋 직후에 확인 (버퍼가 비어 있으므로 한 레코드가 두 파일에 나뉘지 않음)
+        bool commit(bool forceSync = false, bool forceRotate = false) {
+            if (parked) {
+                // 닫을 때 이미 기록했으므로 fdatasync만 필요하면 잠깐 열어서 수행 (회전은 다시 연 뒤 기록 경로에서 확인)
+                return !forceSync || log_file_manager_detail::AppendFile(name).sync();
+            }
+            const size_t bytes = out.buffered();
+            const bool timed = metrics && metrics->timing() && (bytes != 0 || forceSync || policy.syncOnCommit);
+            const auto started = timed ? steady_clock::now() : steady_clock::time_point();
+            fileBytes += bytes;
+            bool ok = out.flush();
+            if (index && !index->flush()) ok = false;  // 항목이 가리키는 로그가 먼저 기록된 뒤에 씀
+            const bool syncing = ok && (forceSync || policy.syncOnCommit);
+            if (syncing) ok = out.sync();
+            if (timed) {
+                metrics->commits.record(
+                    (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - started).count());
+            }
+            count(bytes, syncing, ok);
+            return finishCommit(ok, forceRotate);
+        }
+
+        // 커밋 하나를 카운터에 반영 (mutex 보유 상태, 카운터를 비우는 finishCommit 전에 호출)
+        void count(size_t bytes, bool synced, bool ok) {
+            using log_file_manager_detail::FileCounters;
+            if (bytes == 0 && !synced && ok) return;
+            if (ok) {
+                FileCounters::add(counters.records, uncommittedRecords);
+                FileCounters::add(counters.bytes, bytes);
+            }
+            if (bytes != 0) FileCounters::add(counters.commits, 1);
+            if (synced) FileCounters::add(counters.syncs, 1);
+            if (!ok) FileCounters::add(counters.failures, 1);
+        }
+
+        // 기록(+fdatasync)을 마친 뒤 카운터를 비우고 회전 조건 확인 (commit과 배치 커밋이 공유)
+        bool finishCommit(bool ok, bool forceRotate = false) {
+            uncommittedRecords = 0;
+            lastCommit = steady_clock::now();
+            if (ok && (forceRotate || rotationDue())) ok = rotate();
+            return ok;
+        }
+
+        bool rotationDue() const {
+            if (!rotation.enabled() || fileBytes == 0) return false;
+            if (rotationRetryAt != steady_clock::time_point() && steady_clock::now() < rotationRetryAt) return false;
+            if (rotation.maxBytes != 0 && fileBytes >= rotation.maxBytes) return true;
+            return rotation.daily &&
+                   log_file_manager_detail::dayNumber(std::chrono::system_clock::now(), zone) != currentDay;
+        }
+
+        // 활성 파일을 "<name>.<번호>"로 rename하고 같은 이름으로 다시 엶 (mutex 보유 상태)
+        // 압축/오래된 세그먼트 삭제는 RotationWorker가 백그라운드에서 수행
+        // rename이 실패하면 같은 파일에 계속 기록하고 false (failures 증가). rotationRetryDelay 동안은 다시 시도하지 않음
+        bool rotate() {
+            const std::string segment = name + "." + std::to_string(nextSegment);
+            out.close();  // Windows는 열린 파일을 rename할 수 없으므로 먼저 닫음
+            std::error_code ec;
+            std::filesystem::rename(name, segment, ec);  // 같은 디렉터리 안의 rename은 원자적
+            out.open(name);
+            currentDay = log_file_manager_detail::dayNumber(std::chrono::system_clock::now(), zone);
+            if (ec) {
+                rotationRetryAt = steady_clock::now() + rotationRetryDelay;
+                log_file_manager_detail::FileCounters::add(counters.failures, 1);
+                return false;
+            }
+            rotationRetryAt = steady_clock::time_point();
+            nextSegment++;
+            fileBytes = 0;
+            if (index) index->reset();
+            rotationWorker->submit(segment, name, rotation);
+            return out.is_open();
+        }
+
+        // 디스크립터 캐시가 닫음: 버퍼를 기록하고 로그/인덱스 파일을 닫은 뒤 쓰기 버퍼를 released로 내줌 (mutex 보유 상태)
+        bool park(std::string& released) {
+            if (!commit()) return false;
+            out.close();
+            if (index) index->park();
+            released = out.releaseBuffer();
+            parked = true;
+            return true;
+        }
+
+        bool reopen() {
+            out.open(name);
+            bool ok = out.is_open();
+            if (index && !index->reopen()) ok = false;
+            parked = false;  // 실패해도 열린 것으로 보고 다음 커밋에서 오류를 전달 (회전 후 열기 실패와 같음)
+            return ok;
+        }
+    };
+
+    // 큐 슬롯 하나. 짧은 로그는 슬롯 안에 바로 포맷하고, 긴 로그만 overflow에 힙 할당
+    struct LogRecord {
+        static constexpr size_t inlineBytes = 224;
+
+        LogFile* file = nullptr;  // nullptr: 백그라운드 스레드 깨우기용 빈 레코드
+        void (*expand)(std::string_view, std::string&) = nullptr;  // 지연 포맷 레코드: text는 직렬화된 인자
+        std::int64_t time = 0;  // 기록 시각 (epoch 마이크로초, 타임스탬프 정밀도로 내림. 인덱스용)
+        std::uint32_t size = 0;
+        char text[inlineBytes];
+        std::string overflow;
+
+        std::string_view view() const {
+            return size <= inlineBytes ? std::string_view(text, size) : std::string_view(overflow);
+        }
+    };
+
+    // 비동기 모드 상태. 백그라운드 스레드가 주소를 잡고 있으므로 unique_ptr로 고정
+    struct AsyncWriter {
+        AsyncOptions options;
+        MpmcCircularBuffer<LogRecord, ConsumerWait::Blocking> queue;
+
+        std::atomic<std::uint64_t> enqueued{0};
+        std::atomic<std::uint64_t> written{0};      // 백그라운드 스레드가 파일에 쓴 레코드 수
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> overwritten{0};  // 큐에서 밀려나 버려진 레코드 수
+        std::atomic<bool> inFlight{false};          // 꺼냈지만 아직 파일에 쓰지 않은 레코드가 있음
+        std::atomic<bool> stopping{false};
+        std::atomic<size_t> highWater{0};  // 깨어날 때 본 최대 대기 수 (백그라운드 스레드만 갱신)
+        circular_buffer_detail::WaitGate space;  // BackPressure::Block 생산자가 빈 슬롯을 기다리는 관문
+        log_file_manager_detail::IoBatch io;  // 백그라운드 스레드 전용
+
+        std::mutex drainMutex;
+        std::condition_variable drained;
+        std::thread worker;
+
+        // 버퍼에 남아 있어 시간 조건으로 커밋해야 할 파일 (closeLogFile이 제거)
+        std::mutex uncommittedMutex;
+        std::vector<LogFile*> uncommitted;
+
+        // queueCapacity < 2 또는 batchSize == 0이면 std::invalid_argument (백그라운드 스레드가 진행하지 못함)
+        explicit AsyncWriter(const AsyncOptions& options)
+            : options(validated(options)), queue(options.queueCapacity), io(options.ioBackend) {}
+
+        static const AsyncOptions& validated(const AsyncOptions& options) {
+            if (options.queueCapacity < 2) throw std::invalid_argument("AsyncOptions::queueCapacity는 2 이상이어야 합니다");
+            if (options.batchSize == 0) throw std::invalid_argument("AsyncOptions::batchSize는 1 이상이어야 합니다");
+            return options;
+        }
+    };
+
+    // 열린 로그 파일 LRU 목록 (setFileCache로 켠 경우만). 상한을 넘으면 가장 오래 기록하지 않은 파일부터 닫고
+    // 다음 기록 때 다시 엶. LogFile이 주소를 잡고 있으므로 unique_ptr로 고정
+    // 잠금 순서: LogFile::mutex -> mutex. 닫을 파일은 trim()이 mutex를 잡은 채 try_lock으로 고름 (사용 중이면 건너뜀)
+    struct DescriptorCache {
+        std::mutex mutex;  // 목록/버퍼 풀/카운터 보호
+        LogFile* head = nullptr;  // 가장 최근에 사용
+        LogFile* tail = nullptr;
+        std::atomic<size_t> open{0};
+        std::atomic<size_t> limit{SIZE_MAX};
+        std::atomic<std::uint64_t> relinkDistance{1};
+        std::atomic<std::uint64_t> clock{0};  // 목록 맨 앞에 넣은 횟수
+        size_t pooledBuffers = 64;
+        std::vector<std::string> buffers;  // 닫은 파일이 내준 쓰기 버퍼
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t reopenNanoseconds = 0;
+        std::uint64_t closedHits = 0;  // 닫힌(closeLogFile) 파일의 hits
+
+        void configure(const FileCacheOptions& options) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const size_t max = options.maxOpenFiles == 0 ? SIZE_MAX : options.maxOpenFiles;
+            limit.store(max, std::memory_order_relaxed);
+            // 앞쪽 1/4 안에 있는 파일은 기록해도 옮기지 않음 (자주 쓰는 파일은 mutex를 잡지 않음)
+            relinkDistance.store(std::max<std::uint64_t>(1, max / 4), std::memory_order_relaxed);
+            pooledBuffers = options.pooledBuffers;
+            if (buffers.size() > pooledBuffers) buffers.resize(pooledBuffers);
+        }
+
+        void link(LogFile& file) {  // mutex 보유 상태
+            file.lruPrev = nullptr;
+            file.lruNext = head;
+            if (head) head->lruPrev = &file;
+            head = &file;
+            if (!tail) tail = &file;
+            file.lruLinked = true;
+            file.touchedAt.store(clock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        void unlink(LogFile& file) {  // mutex 보유 상태
+            if (file.lruPrev) file.lruPrev->lruNext = file.lruNext;
+            else head = file.lruNext;
+            if (file.lruNext) file.lruNext->lruPrev = file.lruPrev;
+            else tail = file.lruPrev;
+            file.lruPrev = file.lruNext = nullptr;
+            file.lruLinked = false;
+        }
+
+        // 새로 연 파일 등록 (상한은 이후 trim()에서 맞춤)
+        void add(LogFile& file) {
+            std::lock_guard<std::mutex> lock(mutex);
+            link(file);
+            open.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // 버퍼에 쓰기 직전 호출 (LogFile::mutex 보유 상태). 닫혀 있으면 다시 열고, 아니면 목록 앞쪽으로 옮김
+        // 여러 파일 잠금을 잡은 채로 부를 수 있도록 여기서는 닫지 않음. 다시 열지 못하면 false
+        bool use(LogFile& file) {
+            if (!file.parked) {
+                file.cacheHits++;
+                if (clock.load(std::memory_order_relaxed) - file.touchedAt.load(std::memory_order_relaxed) >=
+                    relinkDistance.load(std::memory_order_relaxed)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    unlink(file);
+                    link(file);
+                }
+                return true;
+            }
+            const auto start = steady_clock::now();
+            const bool ok = file.reopen();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!buffers.empty()) {
+                file.out.adoptBuffer(std::move(buffers.back()));
+                buffers.pop_back();
+            }
+            link(file);
+            open.fetch_add(1, std::memory_order_relaxed);
+            misses++;
+            reopenNanoseconds += (std::uint64_t)elapsed.count();
+            return ok;
+        }
+
+        // closeLogFile: 목록에서 제거 (LogFile::mutex 보유 상태)
+        void forget(LogFile& file) {
+            std::lock_guard<std::mutex> lock(mutex);
+            closedHits += file.cacheHits;
+            if (file.lruLinked) {
+                unlink(file);
+                open.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        // 열린 파일이 상한을 넘으면 목록 끝(가장 오래 쓰지 않은 파일)부터 닫음. 파일 잠금을 잡지 않은 상태에서 호출
+        void trim() {
+            while (open.load(std::memory_order_relaxed) > limit.load(std::memory_order_relaxed)) {
+                LogFile* victim = nullptr;
+                std::unique_lock<std::mutex> victimLock;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (open.load(std::memory_order_relaxed) <= limit.load(std::memory_order_relaxed)) return;
+                    for (LogFile* file = tail; file && !victim; file = file->lruPrev) {
+                        std::unique_lock<std::mutex> attempt(file->mutex, std::try_to_lock);
+                        if (!attempt.owns_lock()) continue;
+                        victim = file;
+                        victimLock = std::move(attempt);
+                    }
+                    if (!victim) return;  // 모두 사용 중: 다음 기록에서 다시 시도
+                    unlink(*victim);
+                    open.fetch_sub(1, std::memory_order_relaxed);
+                }
+                std::string released;
+                const bool ok = victim->park(released);  // 기록/close는 목록 잠금 밖에서
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!ok) {  // 기록 실패: 열어 둔 채로 두고 다음 기록에서 오류 전달
+                    link(*victim);
+                    open.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                evictions++;
+                if (released.capacity() > std::string().capacity() && buffers.size() < pooledBuffers) {
+                    buffers.push_back(std::move(released));
+                }
+            }
+        }
+    };
+
+    // string_view로 바로 조회 (문자열 리터럴/부분 문자열로 호출해도 임시 std::string을 만들지 않음)
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    // 닫으면 file을 비우고 generation을 올린 뒤 재사용 목록에 넣음
+    struct Slot {
+        std::unique_ptr<LogFile> file;
+        std::uint32_t generation = 0;
+    };
+
+    // 파일명 -> 슬롯 번호 해시 맵 + 슬롯 배열로 관리 (핸들은 슬롯 번호로 바로 접근)
+    // 테이블은 읽기 위주: writeLog/readLogs/flush는 공유 잠금, open/close만 배타 잠금
+    // 실제 기록은 파일별 LogFile::mutex(동기) 또는 큐(비동기)로 직렬화되므로 서로 다른 파일끼리는 경합 없음
+    mutable std::shared_mutex tableMutex;
+    // 파일 열기(생성 ~ 테이블 등록)를 직렬화: 같은 파일을 동시에 열 때 진 쪽이 인덱스/바이너리 세션 블록을 쓰지 않도록
+    // 잠금 순서: openMutex -> tableMutex. 쓰기/읽기 경로는 잡지 않으므로 열기 중에도 다른 파일 기록은 막히지 않음
+    std::mutex openMutex;
+    std::unique_ptr<log_file_manager_detail::RotationWorker> rotationWorker;  // 파일보다 늦게 소멸 (닫을 때 회전 가능)
+    std::unique_ptr<DescriptorCache> fileCache;  // setFileCache로 켠 경우만 (파일보다 늦게 소멸)
+    std::unique_ptr<log_file_manager_detail::MetricsState> metricsState =
+        std::make_unique<log_file_manager_detail::MetricsState>();  // 파일보다 늦게 소멸
+    std::unordered_map<std::string, std::uint32_t, NameHash, std::equal_to<>> names;
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::unique_ptr<AsyncWriter> async;
+    std::unique_ptr<log_file_manager_detail::SearchPool> searchPool;  // 처음 search할 때 생성
+
+    TimestampFormat timestampFormat;
+    size_t tailCapacity = 0;  // 새로 여는 텍스트 파일의 최근 레코드 캐시 크기
+    std::atomic<LogLevel> level{LogLevel::Trace};  // LFM_* 매크로의 런타임 최소 심각도
+
+    // 현재 시간을 buffer에 기록 (기본 [YYYY-MM-DD HH:MM:SS], 스레드별 캐시로 초당 한 번만 변환)
+    std::string_view getCurrentTimestamp(char (&buffer)[timestampMaxLength], std::chrono::system_clock::time_point now) const {
+        return std::string_view(buffer, formatTimestamp(buffer, timestampFormat, now));
+    }
+
+    static std::int64_t toMicroseconds(std::chrono::system_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+
+    // 인덱스에 남길 기록 시각: 줄에 찍힌 타임스탬프의 정밀도로 내림
+    // (다시 열 때 텍스트에서 읽어 만든 항목, readRange/search의 줄 필터와 같은 값이 되도록)
+    std::int64_t stampedMicroseconds(std::chrono::system_clock::time_point time) const {
+        using namespace std::chrono;
+        switch (timestampFormat.precision) {
+        case TimestampPrecision::Seconds: return toMicroseconds(floor<seconds>(time));
+        case TimestampPrecision::Milliseconds: return toMicroseconds(floor<milliseconds>(time));
+        case TimestampPrecision::Microseconds: break;
+        }
+        return toMicroseconds(floor<microseconds>(time));
+    }
+
+    // time 이상인 첫 타임스탬프 값 (정밀도 단위로 올림). 그 값보다 먼저 기록된 줄은 모두 time 이전으로 읽힘
+    std::int64_t stampedMicrosecondsCeil(std::chrono::system_clock::time_point time) const {
+        using namespace std::chrono;
+        if (time == system_clock::time_point::max()) return toMicroseconds(time);
+        switch (timestampFormat.precision) {
+        case TimestampPrecision::Seconds: return toMicroseconds(ceil<seconds>(time));
+        case TimestampPrecision::Milliseconds: return toMicroseconds(ceil<milliseconds>(time));
+        case TimestampPrecision::Microseconds: break;
+        }
+        return toMicroseconds(ceil<microseconds>(time));
+    }
+
+    // tableMutex(공유 이상) 보유 상태에서 호출
+    LogFile& findLogFile(std::string_view filename, const char* error) {
+        auto it = names.find(filename);
+        if (it == names.end()) {
+            throw std::runtime_error(error + std::string(filename));
+        }
+        return *slots[it->second].file;
+    }
+
+    LogFile& findLogFile(LogHandle handle, const char* error) {
+        if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation ||
+            !slots[handle.index].file) {
+            throw std::runtime_error(std::string(error) + "(닫혔거나 유효하지 않은 핸들)");
+        }
+        return *slots[handle.index].file;
+    }
+
+    // 백그라운드 스레드에서 발생한 기록 오류를 호출자 스레드로 전달
+    static void rethrowAsyncFailure(LogFile& file) {
+        if (file.failed.exchange(false, std::memory_order_acq_rel)) {
+            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + file.name);
+        }
+    }
+
+    // "[timestamp] message\n"을 슬롯에 바로 기록
+    static void fillRecord(LogRecord& record, LogFile* file, std::int64_t time, std::string_view timestamp,
+                           std::string_view message) {
+        record.file = file;
+        record.expand = nullptr;
+        record.time = time;
+        const size_t size = timestamp.size() + 1 + message.size() + 1;
+        record.size = (std::uint32_t)size;
+        char* out = record.text;
+        if (size > LogRecord::inlineBytes) {
+            record.overflow.resize(size);
+            out = record.overflow.data();
+        }
+        std::memcpy(out, timestamp.data(), timestamp.size());
+        out[timestamp.size()] = ' ';
+        std::memcpy(out + timestamp.size() + 1, message.data(), message.size());
+        out[size - 1] = '\n';
+    }
+
+    // writeLogf 지연 포맷: 형식 문자열 위치와 인자 원시 값만 슬롯에 복사
+    template <typename... Args>
+    static void fillDeferred(LogRecord& record, LogFile* file, std::int64_t time, std::string_view timestamp,
+                             std::string_view format, const Args&... args) {
+        using namespace log_file_manager_detail;
+        record.file = file;
+        record.expand = &expandRecord<Args...>;
+        record.time = time;
+        const size_t size = packedRecordSize(timestamp, args...);
+        record.size = (std::uint32_t)size;
+        char* out = record.text;
+        if (size > LogRecord::inlineBytes) {
+            record.overflow.resize(size);
+            out = record.overflow.data();
+        }
+        packRecord(out, format, timestamp, args...);
+    }
+
+    // 바이너리 레코드를 슬롯에 바로 직렬화 (형식 정의는 백그라운드 스레드가 파일 순서대로 붙임)
+    template <typename... Args>
+    static void fillBinary(LogRecord& record, LogFile* file, std::uint32_t id, std::int64_t nanoseconds,
+                           const Args&... args) {
+        record.file = file;
+        record.expand = nullptr;
+        const size_t size = log_file_manager_detail::binaryRecordSize(args...);
+        record.size = (std::uint32_t)size;
+        char* out = record.text;
+        if (size > LogRecord::inlineBytes) {
+            record.overflow.resize(size);
+            out = record.overflow.data();
+        }
+        log_file_manager_detail::packBinaryRecord(out, id, nanoseconds, args...);
+    }
+
+    template <typename Fill>
+    void enqueue(Fill&& fill) {
+        AsyncWriter& w = *async;
+        switch (w.options.backPressure) {
+        case BackPressure::Block:
+            // 가득 차 있으면 잠깐 spin 후 잠듦 (백그라운드 스레드가 꺼낸 뒤 깨움. 만일을 위해 100ms마다 재확인)
+            while (!w.queue.try_push_with(fill)) {
+                w.space.wait_until([&] { return w.queue.size() < w.queue.capacity(); }, 1,
+                                   steady_clock::now() + std::chrono::milliseconds(100));
+            }
+            break;
+        case BackPressure::Drop:
+            if (!w.queue.try_push_with(fill)) {
+                w.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            break;
+        case BackPressure::Overwrite:
+            while (!w.queue.try_push_with(fill)) {
+                if (w.queue.pop_front()) w.overwritten.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+        w.enqueued.fetch_add(1, std::memory_order_release);
+    }
+
+    // 여러 파일을 한 번에 커밋 (각 LogFile::mutex 보유 상태). LogFile::commit과 같은 순서: 로그 -> 인덱스 -> fdatasync
+    static void commitBatch(log_file_manager_detail::IoBatch& io, const std::vector<LogFile*>& files) {
+        using log_file_manager_detail::IoRequest;
+        log_file_manager_detail::MetricsState* metrics = files.empty() ? nullptr : files.front()->metrics;
+        const bool timed = metrics && metrics->timing();
+        const auto started = timed ? steady_clock::now() : steady_clock::time_point();
+        std::vector<IoRequest> writes;
+        std::vector<size_t> sizes;
+        writes.reserve(files.size());
+        sizes.reserve(files.size());
+        for (LogFile* file : files) {
+            sizes.push_back(file->out.buffered());
+            file->fileBytes += sizes.back();
+            writes.push_back(IoRequest{&file->out});
+        }
+        io.flush(writes);
+
+        std::vector<IoRequest> extra;
+        std::vector<size_t> owner;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (files[i]->index) {
+                extra.push_back(IoRequest{&files[i]->index->output()});
+                owner.push_back(i);
+            }
+        }
+        io.flush(extra);
+        for (size_t j = 0; j < extra.size(); ++j) writes[owner[j]].ok = writes[owner[j]].ok && extra[j].ok;
+
+        extra.clear();
+        owner.clear();
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (writes[i].ok && files[i]->policy.syncOnCommit) {
+                extra.push_back(IoRequest{&files[i]->out});
+                owner.push_back(i);
+            }
+        }
+        io.sync(extra);
+        std::vector<bool> synced(files.size(), false);
+        for (size_t j = 0; j < extra.size(); ++j) {
+            writes[owner[j]].ok = extra[j].ok;
+            synced[owner[j]] = true;
+        }
+        if (timed) {
+            metrics->commits.record(
+                (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - started).count());
+        }
+
+        for (size_t i = 0; i < files.size(); ++i) {
+            files[i]->count(sizes[i], synced[i], writes[i].ok);
+            if (!files[i]->finishCommit(writes[i].ok)) files[i]->failed.store(true, std::memory_order_release);
+        }
+    }
+
+    // 백그라운드 스레드: 쌓인 레코드를 최대 batchSize개 꺼내 파일별로 모은 뒤 파일마다 한 번에 기록
+    static void runWorker(AsyncWriter& w) {
+        static constexpr std::chrono::milliseconds idleWait{100};
+        std::vector<LogFile*> dirty;
+        std::vector<LogFile*> due;
+        std::vector<std::unique_lock<std::mutex>> locks;
+        DescriptorCache* trimCache = nullptr;
+        std::chrono::milliseconds wait = idleWait;
+        for (;;) {
+            w.queue.wait_ready(1, wait);
+            const bool stop = w.stopping.load(std::memory_order_acquire);
+            if (const size_t depth = w.queue.size(); depth > w.highWater.load(std::memory_order_relaxed)) {
+                w.highWater.store(depth, std::memory_order_relaxed);
+            }
+
+            w.inFlight.store(true, std::memory_order_seq_cst);
+            size_t n = 0;
+            while (n < w.options.batchSize && w.queue.try_pop_with([&](LogRecord& record) {
+                       if (LogFile* file = record.file) {
+                           if (file->pending.empty()) dirty.push_back(file);
+                           file->pendingRecords++;
+                           const size_t before = file->pending.size();
+                           if (file->binary) file->appendBinary(record.view(), file->pending);
+                           else if (record.expand) record.expand(record.view(), file->pending);
+                           else file->pending.append(record.view());
+                           if (file->recent) {
+                               const std::string_view text = std::string_view(file->pending).substr(before);
+                               file->remember(text.substr(0, text.size() - 1));
+                           }
+                           // 색인 위치는 잠금 구간에서 계산 (잠금 밖에서 사용자 스레드의 회전이 색인을 초기화할 수 있음)
+                           if (file->index) {
+                               const std::string_view text = std::string_view(file->pending).substr(before);
+                               file->staged.push_back(log_file_manager_detail::StagedRecord{
+                                   text.size(), (std::uint64_t)std::count(text.begin(), text.end(), '\n'), record.time});
+                           }
+                       }
+                       if (record.size > LogRecord::inlineBytes) record.overflow.clear();
+                   })) {
+                ++n;
+            }
+            if (n != 0 && w.options.backPressure == BackPressure::Block) {
+                w.space.notify([&] { return n; });  // 방금 꺼낸 만큼 빈 슬롯이 생김
+            }
+            // 그룹 커밋: 파일마다 정책을 확인해 커밋할 파일을 모은 뒤 write(+fdatasync)를 IoBatch로 한 번에 제출
+            const auto now = steady_clock::now();
+            wait = idleWait;
+            {
+                std::lock_guard<std::mutex> listLock(w.uncommittedMutex);
+                for (LogFile* file : dirty) {
+                    if (std::find(w.uncommitted.begin(), w.uncommitted.end(), file) == w.uncommitted.end())
+                        w.uncommitted.push_back(file);
+                }
+                // 여러 파일의 잠금을 함께 잡으므로 항상 주소 순서로 잡음
+                std::sort(w.uncommitted.begin(), w.uncommitted.end(), std::less<LogFile*>());
+                size_t kept = 0;
+                for (LogFile* file : w.uncommitted) {
+                    std::unique_lock<std::mutex> lock(file->mutex);
+                    if (!file->pending.empty()) {
+                        if (file->cache) {
+                            file->cache->use(*file);  // 다시 열지 못하면 커밋이 실패해 failed로 전달됨
+                            trimCache = file->cache;
+                        }
+                        file->out.append(file->pending);
+                        file->uncommittedRecords += file->pendingRecords;
+                        file->pending.clear();
+                        file->pendingRecords = 0;
+                        for (const auto& staged : file->staged) {
+                            log_file_manager_detail::IndexEntry entry;
+                            if (file->index->track(staged.size, staged.newlines, staged.time, entry)) file->index->add(entry);
+                        }
+                        file->staged.clear();
+                    }
+                    if (file->commitDue(now)) {
+                        due.push_back(file);
+                        locks.push_back(std::move(lock));  // 배치를 제출할 때까지 잠금 유지
+                    } else if (file->uncommittedRecords != 0) {
+                        // 시간 조건이 있으면 그때 다시 깨어남 (없으면 다음 레코드/명시적 flush까지 대기)
+                        if (file->policy.everyInterval.count() != 0) {
+                            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                file->lastCommit + file->policy.everyInterval - now);
+                            wait = std::max(std::chrono::milliseconds(1), std::min(wait, left));
+                        }
+                        w.uncommitted[kept++] = file;  // 아직 커밋하지 않은 파일만 목록에 남김
+                    }
+                }
+                w.uncommitted.resize(kept);
+                if (!due.empty()) commitBatch(w.io, due);
+                locks.clear();
+                due.clear();
+            }
+            dirty.clear();
+            if (trimCache) {
+                trimCache->trim();  // 파일 잠금을 모두 놓은 뒤 상한을 넘은 만큼 닫음
+                trimCache = nullptr;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(w.drainMutex);
+                w.written.fetch_add(n, std::memory_order_release);
+                w.inFlight.store(false, std::memory_order_seq_cst);
+            }
+            w.drained.notify_all();
+
+            if (stop && w.queue.empty()) return;
+        }
+    }
+
+    // 지금까지 큐에 넣은 레코드가 모두 파일에 쓰이거나 버려질 때까지 대기
+    void drainAsync() {
+        if (!async) return;
+        AsyncWriter& w = *async;
+        const std::uint64_t target = w.enqueued.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(w.drainMutex);
+        while (w.written.load(std::memory_order_acquire) + w.overwritten.load(std::memory_order_acquire) < target ||
+               w.inFlight.load(std::memory_order_seq_cst)) {
+            w.drained.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+
+    void commitAll(bool forceSync) {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        drainAsync();
+        std::string failed;
+        for (Slot& slot : slots) {
+            if (!slot.file) continue;
+            std::lock_guard<std::mutex> lock(slot.file->mutex);
+            if (!slot.file->commit(forceSync) && failed.empty()) failed = slot.file->name;
+        }
+        if (!failed.empty()) {
+            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + failed);
+        }
+    }
+
+    void stopAsync() {
+        if (!async) return;
+        async->stopping.store(true, std::memory_order_release);
+        // 대기 중인 스레드 깨우기. 배압 정책을 거치지 않으므로 큐가 가득 차도 기존 레코드를 밀어내지 않음
+        // (실패해도 백그라운드 스레드는 이미 깨어 있거나 idleWait 안에 stopping을 확인)
+        if (async->queue.try_push_with([](LogRecord& record) {
+                record.file = nullptr;
+                record.expand = nullptr;
+                record.size = 0;
+            })) {
+            async->enqueued.fetch_add(1, std::memory_order_release);
+        }
+        async->worker.join();
+        async.reset();
+    }
+
+    // 연 파일을 테이블에 등록 (openMutex 보유 상태에서 호출. 이미 열려 있으면 그쪽을 유지)
+    LogHandle addLogFile(const std::string& filename, std::unique_ptr<LogFile> file) {
+        std::unique_lock<std::shared_mutex> table(tableMutex);
+        auto it = names.find(filename);
+        if (it != names.end()) {
+            return LogHandle{it->second, slots[it->second].generation};
+        }
+        std::uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = (std::uint32_t)slots.size();
+            slots.emplace_back();
+        }
+        file->metrics = metricsState.get();
+        slots[index].file = std::move(file);
+        names.emplace(filename, index);
+        const LogHandle handle{index, slots[index].generation};
+        if (fileCache) {
+            LogFile& added = *slots[index].file;
+            added.cache = fileCache.get();
+            fileCache->add(added);
+            table.unlock();
+            fileCache->trim();  // 이 파일 때문에 상한을 넘었으면 가장 오래 쓰지 않은 파일을 닫음
+        }
+        return handle;
+    }
+
+    // setMetricsEnabled(true)인 동안 writeLog/writeLogf 호출 하나의 시간을 히스토그램에 기록
+    class WriteTimer {
+    private:
+        log_file_manager_detail::MetricsState* state;
+        steady_clock::time_point start;
+
+    public:
+        explicit WriteTimer(log_file_manager_detail::MetricsState* metrics)
+            : state(metrics && metrics->timing() ? metrics : nullptr),
+              start(state ? steady_clock::now() : steady_clock::time_point()) {}
+        WriteTimer(const WriteTimer&) = delete;
+        WriteTimer& operator=(const WriteTimer&) = delete;
+        ~WriteTimer() {
+            if (state) {
+                state->writes.record(
+                    (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count());
+            }
+        }
+    };
+
+    // 디스크립터 캐시가 닫은 파일이면 다시 엶 (동기 기록 경로, LogFile::mutex 보유 상태)
+    static void useFile(LogFile& file) {
+        if (file.cache && !file.cache->use(file)) {
+            throw std::runtime_error("로그 파일을 다시 열 수 없습니다: " + file.name);
+        }
+    }
+
+    // writeLog 공통 부분 (tableMutex 공유 잠금 보유 상태에서 호출)
+    void write(LogFile& file, std::string_view message) {
+        if (file.binary) {  // 메시지 전체를 문자열 인자 하나로 기록
+            writeFormatted(file, plainFormat, message);
+            return;
+        }
+        const auto now = std::chrono::system_clock::now();
+        char buffer[timestampMaxLength];
+        const std::string_view timestamp = getCurrentTimestamp(buffer, now);
+        if (async) {
+            rethrowAsyncFailure(file);
+            enqueue([&](LogRecord& record) { fillRecord(record, &file, stampedMicroseconds(now), timestamp, message); });
+            return;
+        }
+
+        // append 모드이므로 항상 파일 끝에 기록됨. 정책에 맞을 때만 write 시스템 콜 발생
+        // (동기 모드의 시간 조건은 다음 writeLog/flush 시점에 확인)
+        std::unique_lock<std::mutex> lock(file.mutex);
+        useFile(file);
+        // 날짜가 바뀌었으면 이 줄을 쓰기 전에 이전 내용을 커밋하고 회전 (비동기 모드는 배치 커밋 시점에 확인)
+        if (file.rotation.daily && file.fileBytes + file.out.buffered() != 0 &&
+            log_file_manager_detail::dayNumber(now, file.zone) != file.currentDay && !file.commit(false, true)) {
+            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + file.name);
+        }
+        log_file_manager_detail::IndexEntry entry;
+        if (file.index && file.index->track(timestamp.size() + message.size() + 2,
+                                            1 + (std::uint64_t)std::count(message.begin(), message.end(), '\n'),
+                                            stampedMicroseconds(now), entry)) {
+            file.index->add(entry);
+        }
+        file.out.append(timestamp);
+        file.out.append(" ");
+        file.out.append(message);
+        file.out.append("\n");
+        file.uncommittedRecords++;
+        if (file.recent) file.remember(timestamp, " ", message);
+
+        if (file.commitDueNow() && !file.commit()) {
+            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + file.name);
+        }
+        lock.unlock();
+        if (file.cache) file.cache->trim();
+    }
+
+    // writeLogf 공통 부분 (tableMutex 공유 잠금 보유 상태에서 호출)
+    template <typename... Args>
+    void writeFormatted(LogFile& file, std::string_view format, const Args&... args) {
+        using namespace log_file_manager_detail;
+        if (file.binary) {
+            const std::uint32_t id = binaryFormatId<Args...>(format);
+            const std::int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 std::chrono::system_clock::now().time_since_epoch())
+                                                 .count();
+            if (async) {
+                rethrowAsyncFailure(file);
+                enqueue([&](LogRecord& record) { fillBinary(record, &file, id, nanoseconds, args...); });
+                return;
+            }
+            std::string& buffer = threadFormatBuffer();
+            buffer.resize(binaryRecordSize(args...));
+            packBinaryRecord(buffer.data(), id, nanoseconds, args...);
+            std::unique_lock<std::mutex> lock(file.mutex);
+            useFile(file);
+            file.appendBinary(buffer, file.out);
+            file.uncommittedRecords++;
+            if (file.commitDueNow() && !file.commit()) {
+                throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + file.name);
+            }
+            lock.unlock();
+            if (file.cache) file.cache->trim();
+            return;
+        }
+        if (async && async->options.deferFormatting) {
+            rethrowAsyncFailure(file);
+            const auto now = std::chrono::system_clock::now();
+            char buffer[timestampMaxLength];
+            const std::string_view timestamp = getCurrentTimestamp(buffer, now);
+            enqueue([&](LogRecord& record) {
+                fillDeferred(record, &file, stampedMicroseconds(now), timestamp, format, args...);
+            });
+            return;
+        }
+        // 스레드별 버퍼에 바로 포맷 (capacity 재사용)
+        std::string& message = threadFormatBuffer();
+        formatTo(message, format, args...);
+        write(file, message);
+    }
+
+    // 아직 버퍼/큐에 있는 로그를 파일에 기록하고 경로를 반환 (매핑/순회는 잠금 밖에서 수행)
+    // locate(LogFile&)가 주어지면 같은 잠금 안에서 호출 (인덱스 조회용)
+    // 바이너리 파일은 AllowBinary(readLogs 전체 읽기)일 때만 허용
+    template <bool AllowBinary = false, typename Key, typename Locate = std::nullptr_t>
+    std::string commitForRead(Key key, Locate&& locate = nullptr) {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        LogFile& logFile = findLogFile(key, "열려 있지 않은 파일 읽기 시도: ");
+        if (!AllowBinary && logFile.binary) {
+            throw std::runtime_error("바이너리 로그는 readLogs(전체) 또는 decodeBinaryLog로 읽어야 합니다: " + logFile.name);
+        }
+        drainAsync();
+        std::lock_guard<std::mutex> lock(logFile.mutex);
+        if (logFile.out.buffered() != 0 && !logFile.commit()) {
+            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + logFile.name);
+        }
+        if constexpr (!std::is_null_pointer_v<std::decay_t<Locate>>) locate(logFile);
+        return logFile.name;
+    }
+
+    // first번째 줄(0부터)부터 count줄. 인덱스가 있으면 가장 가까운 항목 위치부터 읽음
+    template <typename Key>
+    std::vector<std::string> readLineRange(Key key, std::uint64_t first, size_t count) {
+        log_file_manager_detail::IndexEntry start;
+        const std::string path = commitForRead(key, [&](LogFile& file) {
+            if (file.index) start = file.index->findLine(first);
+        });
+        std::vector<std::string> logs;
+        const LogLines lines(path, start.offset);
+        std::uint64_t line = start.line;
+        for (auto it = lines.begin(); it != lines.end() && logs.size() < count; ++it, ++line) {
+            if (line >= first) logs.emplace_back(*it);
+        }
+        return logs;
+    }
+
+    // 타임스탬프가 [from, to)인 줄. 인덱스로 시작 위치를 찾고, to 이후 타임스탬프가 나오면 중단
+    // (타임스탬프가 없는 줄은 여러 줄 메시지의 일부로 보고 직전 줄의 포함 여부를 따름)
+    template <typename Key>
+    std::vector<std::string> readTimeRange(Key key, std::chrono::system_clock::time_point from,
+                                           std::chrono::system_clock::time_point to) {
+        const std::int64_t t0 = toMicroseconds(from);
+        const std::int64_t t1 = toMicroseconds(to);
+        log_file_manager_detail::IndexEntry start;
+        const std::string path = commitForRead(key, [&](LogFile& file) {
+            if (file.index) start = file.index->findTime(t0);
+        });
+        std::vector<std::string> logs;
+        const TimestampZone zone = timestampFormat.zone;
+        bool inside = false;
+        for (std::string_view line : LogLines(path, start.offset)) {
+            std::int64_t time;
+            if (parseTimestamp(line, zone, time)) {
+                if (time >= t1) break;
+                inside = time >= t0;
+            }
+            if (inside) logs.emplace_back(line);
+        }
+        return logs;
+    }
+
+    // callback(std::string_view)이 bool을 반환하면 false에서 중단. 마지막으로 처리한 줄 다음 위치 반환
+    template <typename Callback>
+    static std::uint64_t visitLines(const LogLines& lines, Callback& callback) {
+        auto it = lines.begin();
+        for (; it != lines.end(); ++it) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Callback&, std::string_view>, bool>) {
+                if (!callback(*it)) return (++it).offset();
+            } else {
+                callback(*it);
+            }
+        }
+        return lines.size();
+    }
+
+    template <typename Key>
+    std::vector<std::string> readAll(Key key) {
+        bool rotated = false;
+        size_t maxFiles = 0;
+        bool binary = false;
+        const std::string path = commitForRead<true>(key, [&](LogFile& file) {
+            rotated = file.rotation.enabled();
+            maxFiles = file.rotation.maxFiles;
+            binary = file.binary;
+        });
+        std::vector<std::string> logs;
+        auto collect = [&](std::string_view line) { logs.emplace_back(line); };
+        if (binary) {
+            decodeBinaryLogFile(path, collect, timestampFormat);
+            return logs;
+        }
+        if (rotated) {
+            const auto segments = log_file_manager_detail::listSegments(path);
+            // 보관 개수를 넘는 세그먼트는 백그라운드에서 곧 삭제되므로 건너뜀 (읽는 도중 지워져 중간이 빠지지 않도록)
+            const size_t skip = maxFiles != 0 && segments.size() > maxFiles ? segments.size() - maxFiles : 0;
+            for (size_t i = skip; i < segments.size(); ++i) log_file_manager_detail::readSegment(segments[i], collect);
+        }
+        for (std::string_view line : LogLines(path)) collect(line);
+        return logs;
+    }
+
+    static LogPage readPage(const LogLines& lines, size_t maxLines) {
+        LogPage page;
+        auto it = lines.begin();
+        for (; it != lines.end() && page.lines.size() < maxLines; ++it) page.lines.emplace_back(*it);
+        page.nextOffset = it.offset();
+        page.end = it == lines.end();
+        return page;
+    }
+
+    // 캐시가 있으면 메모리에서 최근 n개 레코드, 없으면 파일 끝에서부터 n줄
+    template <typename Key>
+    std::vector<std::string> readTail(Key key, size_t n) {
+        {
+            std::shared_lock<std::shared_mutex> table(tableMutex);
+            LogFile& file = findLogFile(key, "열려 있지 않은 파일 읽기 시도: ");
+            if (file.binary) {  // 캐시 경로도 commitForRead와 같이 거부 (레코드 원시 바이트를 줄로 돌려주지 않도록)
+                throw std::runtime_error("바이너리 로그는 readLogs(전체) 또는 decodeBinaryLog로 읽어야 합니다: " + file.name);
+            }
+            if (file.recent) {
+                drainAsync();  // 큐에 남은 로그까지 반영 (파일은 읽지 않음)
+                std::lock_guard<std::mutex> lock(file.tailMutex);
+                const auto count = (std::ptrdiff_t)std::min(n, file.recent->size());
+                return std::vector<std::string>(file.recent->end() - count, file.recent->end());
+            }
+        }
+        const std::string path = commitForRead(key);
+        const log_file_manager_detail::MappedFile file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("파일을 열 수 없습니다: " + path);
+        }
+        std::vector<std::string> logs;
+        const std::string_view data = file.view();
+        for (size_t pos = log_file_manager_detail::tailOffset(data, n); pos < data.size();) {
+            size_t newline = data.find('\n', pos);
+            if (newline == std::string_view::npos) newline = data.size();
+            logs.emplace_back(data.substr(pos, newline - pos));
+            pos = newline + 1;
+        }
+        return logs;
+    }
+
+    // 인덱스가 있고 시각 범위가 주어지면 범위에 해당하는 구간만 검색
+    template <typename Key, typename Callback>
+    std::uint64_t searchLines(Key key, std::string_view pattern, Callback& callback, const SearchOptions& options) {
+        if (pattern.find('\n') != std::string_view::npos) {
+            throw std::runtime_error("검색어에 줄바꿈을 넣을 수 없습니다");
+        }
+        const bool timed = options.timed();
+        const std::int64_t t0 = toMicroseconds(options.from);
+        const std::int64_t t1 = toMicroseconds(options.to);
+        std::uint64_t begin = 0;
+        std::uint64_t end = UINT64_MAX;
+        log_file_manager_detail::SearchPool* pool;
+        const std::string path = commitForRead(key, [&](LogFile& file) {
+            if (timed && file.index) {
+                begin = file.index->findTime(t0).offset;
+                // 줄 필터는 타임스탬프 정밀도로 비교하므로 잘라내는 위치도 to를 같은 단위로 올려서 찾음
+                // (이전 버전이 기록 시각을 그대로 남긴 인덱스에서도 필터가 받아들일 줄을 건너뛰지 않도록)
+                end = file.index->offsetFrom(stampedMicrosecondsCeil(options.to));
+            }
+        });
+        {
+            std::unique_lock<std::shared_mutex> table(tableMutex);
+            if (!searchPool) {
+                searchPool = std::make_unique<log_file_manager_detail::SearchPool>(std::thread::hardware_concurrency());
+            }
+            pool = searchPool.get();
+        }
+        const log_file_manager_detail::MappedFile file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("파일을 열 수 없습니다: " + path);
+        }
+        return log_file_manager_detail::searchData(*pool, file.view(), (size_t)begin,
+                                                   (size_t)std::min<std::uint64_t>(end, SIZE_MAX), pattern, timed, t0,
+                                                   t1, timestampFormat.zone, options, callback);
+    }
+
+    template <typename Key>
+    std::vector<LogMatch> searchAll(Key key, std::string_view pattern, const SearchOptions& options) {
+        std::vector<LogMatch> matches;
+        auto collect = [&](std::string_view line, std::uint64_t offset) {
+            matches.push_back(LogMatch{offset, std::string(line)});
+        };
+        searchLines(key, pattern, collect, options);
+        return matches;
+    }
+
+    void commit(LogFile& file) {
+        drainAsync();
+        std::lock_guard<std::mutex> lock(file.mutex);
+        if (!file.commit()) {
+            throw std::runtime_error("로그 기록 중 물리적 오류 발생: " + file.name);
+        }
+    }
+
+    // tableMutex 배타 잠금 보유 상태에서 호출
+    void close(std::uint32_t index) {
+        Slot& slot = slots[index];
+        drainAsync();  // 이 파일을 가리키는 대기 레코드가 남지 않도록
+        if (async) {
+            std::lock_guard<std::mutex> lock(async->uncommittedMutex);
+            auto& list = async->uncommitted;
+            list.erase(std::remove(list.begin(), list.end(), slot.file.get()), list.end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(slot.file->mutex);
+            if (slot.file->cache) slot.file->cache->forget(*slot.file);
+            slot.file->commit();  // 남은 버퍼를 카운터에 반영한 뒤 누적 (오류는 소멸자와 같이 무시)
+            LogFileMetrics counted;
+            slot.file->counters.read(counted);
+            LogFileMetrics& closed = metricsState->closed;
+            closed.records += counted.records;
+            closed.bytes += counted.bytes;
+            closed.commits += counted.commits;
+            closed.syncs += counted.syncs;
+            closed.failures += counted.failures;
+        }
+        names.erase(names.find(slot.file->name));
+        slot.file.reset();  // 남은 버퍼 커밋 후 닫기
+        slot.generation++;  // 이전 핸들 무효화
+        freeSlots.push_back(index);
+    }
+
+public:
+    LogFileManager() = default;
+
+    // 비동기 모드: writeLog는 큐 슬롯에 포맷만 하고 바로 반환, 백그라운드 스레드가 배치로 기록
+    explicit LogFileManager(const AsyncOptions& options) : async(std::make_unique<AsyncWriter>(options)) {
+        AsyncWriter* w = async.get();
+        w->worker = std::thread([w] { runWorker(*w); });
+    }
+
+    // 복사 금지 (파일 자원 독점 보장)
+    LogFileManager(const LogFileManager&) = delete;
+    LogFileManager& operator=(const LogFileManager&) = delete;
+
+    // 이동 허용 (noexcept를 통한 성능 최적화)
+    // 백그라운드 스레드는 AsyncWriter 주소만 사용하므로 이동 후에도 그대로 동작
+    // (이동 중인 객체를 다른 스레드가 사용하지 않아야 함)
+    // 원본은 빈 관리자로 계속 쓸 수 있도록 새 지표 상태를 받음
+    LogFileManager(LogFileManager&& other) noexcept
+        : rotationWorker(std::move(other.rotationWorker)),
+          fileCache(std::move(other.fileCache)),
+          metricsState(std::move(other.metricsState)),
+          names(std::move(other.names)),
+          slots(std::move(other.slots)),
+          freeSlots(std::move(other.freeSlots)),
+          async(std::move(other.async)),
+          searchPool(std::move(other.searchPool)),
+          timestampFormat(other.timestampFormat),
+          tailCapacity(other.tailCapacity),
+          level(other.level.load(std::memory_order_relaxed)) {
+        other.metricsState = std::make_unique<log_file_manager_detail::MetricsState>();
+    }
+    LogFileManager& operator=(LogFileManager&& other) noexcept {
+        if (this != &other) {
+            stopAsync();  // 기존 파일을 닫기 전에 대기 중인 로그를 모두 기록
+            timestampFormat = other.timestampFormat;
+            tailCapacity = other.tailCapacity;
+            level.store(other.level.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            names = std::move(other.names);
+            slots = std::move(other.slots);
+            freeSlots = std::move(other.freeSlots);
+            rotationWorker = std::move(other.rotationWorker);  // 기존 파일이 닫히며 남긴 작업을 마친 뒤 교체
+            fileCache = std::move(other.fileCache);
+            metricsState = std::move(other.metricsState);
+            other.metricsState = std::make_unique<log_file_manager_detail::MetricsState>();
+            async = std::move(other.async);
+            searchPool = std::move(other.searchPool);
+        }
+        return *this;
+    }
+
+    // 로그 줄 앞 타임스탬프 형식 (기본: [YYYY-MM-DD HH:MM:SS] 로컬 시간). 파일을 열기 전에 설정
+    void setTimestampFormat(const TimestampFormat& format) { timestampFormat = format; }
+
+    // 이후 openLogFile로 여는 파일마다 최근 records개 레코드를 메모리에 보관 (0: 사용 안 함, 기본값)
+    // tail(name, n)이 파일을 읽지 않고 응답. 열 때 기존 파일의 마지막 줄로 미리 채움 (바이너리 파일은 제외)
+    void setTailCapacity(size_t records) { tailCapacity = records; }
+
+    // 열린 파일 디스크립터 수 상한. 이후 openLogFile/openBinaryLog로 여는 파일에 적용
+    // 상한을 넘으면 가장 오래 기록하지 않은 파일의 버퍼를 기록하고 닫았다가 다음 writeLog 때 다시 엶
+    // 닫은 파일의 쓰기 버퍼는 options.pooledBuffers개까지 보관해 다시 여는 파일이 재사용. 다시 호출하면 상한을 바꿈
+    // (비동기 모드는 배치 하나가 쓰는 파일을 모두 연 뒤에 닫으므로 그동안 상한을 잠시 넘을 수 있음)
+    void setFileCache(const FileCacheOptions& options) {
+        {
+            std::unique_lock<std::shared_mutex> table(tableMutex);
+            if (!fileCache) fileCache = std::make_unique<DescriptorCache>();
+            fileCache->configure(options);
+        }
+        fileCache->trim();
+    }
+
+    // 디스크립터 캐시 통계 (setFileCache 전에는 모두 0)
+    FileCacheStats fileCacheStats() {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        FileCacheStats stats;
+        if (!fileCache) return stats;
+        for (Slot& slot : slots) {
+            if (!slot.file || !slot.file->cache) continue;
+            std::lock_guard<std::mutex> lock(slot.file->mutex);
+            stats.hits += slot.file->cacheHits;
+        }
+        std::lock_guard<std::mutex> lock(fileCache->mutex);
+        stats.hits += fileCache->closedHits;
+        stats.misses = fileCache->misses;
+        stats.evictions = fileCache->evictions;
+        stats.reopenNanoseconds = fileCache->reopenNanoseconds;
+        stats.openFiles = fileCache->open.load(std::memory_order_relaxed);
+        stats.pooledBuffers = fileCache->buffers.size();
+        return stats;
+    }
+
+    // 1. 로그 파일 오픈 (policy: 이 파일의 flush/fdatasync 정책)
+    // 이미 열려 있으면 기존 파일의 핸들을 반환 (policy는 처음 열 때만 적용)
+    // indexEvery > 0이면 약 indexEvery줄마다 위치/시각을 "<filename>.idx"에 기록 (readLines/readRange 가속)
+    // 인덱스가 로그보다 뒤처져 있으면 열 때 빠진 부분만 다시 읽어 이어서 만듦
+    LogHandle openLogFile(const std::string& filename, const FlushPolicy& policy = FlushPolicy(),
+                          std::uint32_t indexEvery = 0) {
+        return openLogFile(filename, policy, RotationPolicy(), indexEvery);
+    }
+
+    // rotation: 크기/날짜 기준 회전과 보관 개수, 회전된 세그먼트 압축
+    LogHandle openLogFile(const std::string& filename, const FlushPolicy& policy, const RotationPolicy& rotation,
+                          std::uint32_t indexEvery = 0) {
+        std::lock_guard<std::mutex> opening(openMutex);  // 이미 열린 파일의 .idx를 다시 만들지 않도록 확인부터 등록까지
+        {
+            std::shared_lock<std::shared_mutex> table(tableMutex);
+            auto it = names.find(filename);
+            if (it != names.end()) return LogHandle{it->second, slots[it->second].generation};
+        }
+
+        // 추가(append) 전용으로 열고, 읽기는 readLogs가 별도로 수행
+        // 파일 열기(시스템 콜)는 tableMutex 밖에서 수행해 다른 파일의 writeLog를 막지 않음
+#if !defined(LOGFILEMANAGER_WITH_ZLIB)
+        if (rotation.compress) {
+            throw std::runtime_error("압축 기능이 비활성화되어 있습니다 (LOGFILEMANAGER_WITH_ZLIB로 빌드 필요): " + filename);
+        }
+#endif
+        log_file_manager_detail::RotationWorker* worker = nullptr;
+        if (rotation.enabled()) {
+            std::unique_lock<std::shared_mutex> table(tableMutex);
+            if (!rotationWorker) rotationWorker = std::make_unique<log_file_manager_detail::RotationWorker>();
+            worker = rotationWorker.get();
+        }
+        auto file = std::make_unique<LogFile>(filename, policy, indexEvery, rotation, worker, timestampFormat.zone,
+                                              tailCapacity);
+
+        if (!file->out.is_open()) {
+            throw std::runtime_error("파일을 열 수 없습니다: " + filename);
+        }
+        return addLogFile(filename, std::move(file));
+    }
+
+    // 바이너리 형식으로 열기: writeLog/writeLogf가 텍스트 변환 없이 형식 ID + 시각 + 인자 원시 값만 기록
+    // (읽기는 readLogs(전체) 또는 decodeBinaryLog. 회전/인덱스와 그 밖의 읽기/tail/search는 지원하지 않음)
+    LogHandle openBinaryLog(const std::string& filename, const FlushPolicy& policy = FlushPolicy()) {
+        // 확인부터 등록까지 직렬화: 이미 열린 파일에 세션 블록을 다시 써서 형식 정의가 지워지지 않도록
+        std::lock_guard<std::mutex> opening(openMutex);
+        {
+            std::shared_lock<std::shared_mutex> table(tableMutex);
+            auto it = names.find(filename);
+            if (it != names.end()) return LogHandle{it->second, slots[it->second].generation};
+        }
+        auto file = std::make_unique<LogFile>(filename, policy, 0, RotationPolicy(), nullptr, timestampFormat.zone);
+        if (!file->out.is_open()) {
+            throw std::runtime_error("파일을 열 수 없습니다: " + filename);
+        }
+        file->startBinary();
+        return addLogFile(filename, std::move(file));
+    }
+
+    // 2. 로그 기록
+    void writeLog(std::string_view filename, std::string_view message) {
+        const WriteTimer timer(metricsState.get());
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        write(findLogFile(filename, "열려 있지 않은 파일에 기록 시도: "), message);
+    }
+
+    // 핸들로 기록 (파일명 해시/비교 없이 슬롯에 바로 접근)
+    void writeLog(LogHandle handle, std::string_view message) {
+        const WriteTimer timer(metricsState.get());
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        write(findLogFile(handle, "열려 있지 않은 파일에 기록 시도: "), message);
+    }
+
+    // 형식 문자열 기록: writeLogf(handle, "id={} took={}ms", id, ms)
+    // 인자를 std::to_chars로 스레드별 버퍼에 바로 변환하므로 호출 측 문자열 조립/할당이 필요 없음
+    // "{}" 개수와 인자 수는 컴파일 타임에 검사
+    template <typename... Args>
+    void writeLogf(LogHandle handle, LogFormatString<Args...> format, const Args&... args) {
+        const WriteTimer timer(metricsState.get());
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        writeFormatted(findLogFile(handle, "열려 있지 않은 파일에 기록 시도: "), format.view(),
+                       log_file_manager_detail::toLogArg(args)...);
+    }
+
+    template <typename... Args>
+    void writeLogf(std::string_view filename, LogFormatString<Args...> format, const Args&... args) {
+        const WriteTimer timer(metricsState.get());
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        writeFormatted(findLogFile(filename, "열려 있지 않은 파일에 기록 시도: "), format.view(),
+                       log_file_manager_detail::toLogArg(args)...);
+    }
+
+    // 런타임 최소 심각도 (LFM_* 매크로가 확인. 기본 Trace = 모두 기록). 실행 중 언제든 바꿀 수 있음
+    void setLogLevel(LogLevel minimum) { level.store(minimum, std::memory_order_relaxed); }
+    LogLevel logLevel() const { return level.load(std::memory_order_relaxed); }
+    bool isEnabled(LogLevel severity) const { return severity >= level.load(std::memory_order_relaxed); }
+
+    // 속도 제한/중복 억제를 거쳐 기록 (LFM_*_LIMITED / LFM_*_DEDUP 매크로가 호출)
+    // 억제된 개수는 다음에 기록되는 줄 앞에 별도의 줄로 남김
+    template <typename Target, typename... Args>
+    void writeLogAt(LogCallSite& site, const Target& target, LogFormatString<Args...> format, const Args&... args) {
+        using namespace log_file_manager_detail;
+        const LogCallSite::Decision decision = site.admit(site.dedups() ? argHash(toLogArg(args)...) : 0);
+        if (!decision.write && decision.repeated == 0 && decision.suppressed == 0) return;
+        const WriteTimer timer(metricsState.get());
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        LogFile& file = findLogFile(target, "열려 있지 않은 파일에 기록 시도: ");
+        if (decision.repeated != 0) writeFormatted(file, "직전 메시지가 {}번 더 반복됨", decision.repeated);
+        if (decision.suppressed != 0) writeFormatted(file, "속도 제한으로 로그 {}건 생략", decision.suppressed);
+        if (decision.write) writeFormatted(file, format.view(), toLogArg(args)...);
+    }
+
+    // 3. 로그 읽기 (페이지/스트리밍/줄 번호/시각 기준 읽기는 활성 파일만 대상)
+    // openBinaryLog로 연 파일은 readLogs(전체)만 지원: 나머지 읽기/tail/search는 std::runtime_error
+    // 아직 버퍼/큐에 있는 로그를 먼저 파일에 기록한 뒤, 쓰기와 별도로 파일을 매핑해 처음부터 읽음
+    // 회전을 켠 파일은 회전된 세그먼트(.gz 포함)를 오래된 것부터 이어서 읽음
+    std::vector<std::string> readLogs(std::string_view filename) { return readAll(filename); }
+    std::vector<std::string> readLogs(LogHandle handle) { return readAll(handle); }
+
+    // 페이지 단위 읽기: offset(바이트, 줄의 시작)부터 최대 maxLines줄. 다음 페이지는 page.nextOffset부터
+    LogPage readLogs(std::string_view filename, std::uint64_t offset, size_t maxLines) {
+        return readPage(LogLines(commitForRead(filename), offset), maxLines);
+    }
+    LogPage readLogs(LogHandle handle, std::uint64_t offset, size_t maxLines) {
+        return readPage(LogLines(commitForRead(handle), offset), maxLines);
+    }
+
+    // 스트리밍 읽기: 파일을 매핑해 줄마다 할당 없이 std::string_view를 돌려주는 lazy range
+    // (반환 후에는 잠금을 잡지 않으므로 순회 중에도 기록/닫기가 막히지 않음. 매핑 이후 추가된 줄은 보이지 않음)
+    LogLines readLogLines(std::string_view filename, std::uint64_t offset = 0) {
+        return LogLines(commitForRead(filename), offset);
+    }
+    LogLines readLogLines(LogHandle handle, std::uint64_t offset = 0) { return LogLines(commitForRead(handle), offset); }
+
+    // 줄마다 callback(std::string_view) 호출. callback이 bool을 반환하면 false에서 중단
+    // 반환값: 다음에 이어 읽을 바이트 위치
+    template <typename Callback>
+    std::uint64_t forEachLog(std::string_view filename, Callback&& callback, std::uint64_t offset = 0) {
+        return visitLines(LogLines(commitForRead(filename), offset), callback);
+    }
+    template <typename Callback>
+    std::uint64_t forEachLog(LogHandle handle, Callback&& callback, std::uint64_t offset = 0) {
+        return visitLines(LogLines(commitForRead(handle), offset), callback);
+    }
+
+    // 줄 번호(0부터)로 읽기: first번째 줄부터 최대 count줄
+    std::vector<std::string> readLines(std::string_view filename, std::uint64_t first, size_t count) {
+        return readLineRange(filename, first, count);
+    }
+    std::vector<std::string> readLines(LogHandle handle, std::uint64_t first, size_t count) {
+        return readLineRange(handle, first, count);
+    }
+
+    // 기록 시각으로 읽기: 타임스탬프가 [from, to)인 줄
+    std::vector<std::string> readRange(std::string_view filename, std::chrono::system_clock::time_point from,
+                                       std::chrono::system_clock::time_point to) {
+        return readTimeRange(filename, from, to);
+    }
+    std::vector<std::string> readRange(LogHandle handle, std::chrono::system_clock::time_point from,
+                                       std::chrono::system_clock::time_point to) {
+        return readTimeRange(handle, from, to);
+    }
+
+    // 최근 n개 로그 (오래된 것부터). 캐시가 켜져 있으면 메모리에서 O(n)으로 응답하고 최대 캐시 크기만큼 반환
+    // 캐시가 없으면 파일을 매핑해 끝에서부터 n줄을 찾음 (여러 줄 메시지는 캐시에서는 한 항목, 파일에서는 줄마다)
+    std::vector<std::string> tail(std::string_view filename, size_t n) { return readTail(filename, n); }
+    std::vector<std::string> tail(LogHandle handle, size_t n) { return readTail(handle, n); }
+
+    // 문자열 검색: pattern이 들어 있는 줄 (활성 파일만 대상)
+    // 파일을 매핑해 줄 경계에 맞춘 청크로 나누고 스레드 풀에서 병렬로 훑되, 결과는 파일 순서대로 돌려줌
+    // options.from/to가 있으면 타임스탬프로 거르고, 인덱스가 있으면 범위 밖 구간은 아예 읽지 않음
+    std::vector<LogMatch> search(std::string_view filename, std::string_view pattern,
+                                 const SearchOptions& options = SearchOptions()) {
+        return searchAll(filename, pattern, options);
+    }
+    std::vector<LogMatch> search(LogHandle handle, std::string_view pattern,
+                                 const SearchOptions& options = SearchOptions()) {
+        return searchAll(handle, pattern, options);
+    }
+
+    // 스트리밍 검색: 맞는 줄마다 파일 순서대로 callback(std::string_view line, std::uint64_t offset) 호출
+    // 앞쪽 청크의 결과는 뒤쪽 청크를 검색하는 동안 전달됨. callback이 bool을 반환하면 false에서 중단
+    // 반환값: 전달한 줄 수
+    template <typename Callback>
+        requires std::is_invocable_v<Callback&, std::string_view, std::uint64_t>
+    std::uint64_t search(std::string_view filename, std::string_view pattern, Callback&& callback,
+                         const SearchOptions& options = SearchOptions()) {
+        return searchLines(filename, pattern, callback, options);
+    }
+    template <typename Callback>
+        requires std::is_invocable_v<Callback&, std::string_view, std::uint64_t>
+    std::uint64_t search(LogHandle handle, std::string_view pattern, Callback&& callback,
+                         const SearchOptions& options = SearchOptions()) {
+        return searchLines(handle, pattern, callback, options);
+    }
+
+    // 4. 로그 파일 닫기 (열려 있지 않으면 무시)
+    void closeLogFile(std::string_view filename) {
+        std::unique_lock<std::shared_mutex> table(tableMutex);  // 이 파일을 사용 중인 호출이 끝날 때까지 대기
+        auto it = names.find(filename);
+        if (it != names.end()) close(it->second);
+    }
+
+    void closeLogFile(LogHandle handle) {
+        std::unique_lock<std::shared_mutex> table(tableMutex);
+        if (handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+            slots[handle.index].file) {
+            close(handle.index);
+        }
+    }
+
+    // 해당 파일의 대기/버퍼 내용을 즉시 write (정책이 syncOnCommit이면 fdatasync까지)
+    void flush(std::string_view filename) {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        commit(findLogFile(filename, "열려 있지 않은 파일 flush 시도: "));
+    }
+
+    void flush(LogHandle handle) {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        commit(findLogFile(handle, "열려 있지 않은 파일 flush 시도: "));
+    }
+
+    // 모든 파일의 대기/버퍼 내용을 write
+    void flushAll() { commitAll(false); }
+
+    // 모든 파일을 write 후 fdatasync까지 수행 (정책과 무관하게 디스크에 기록)
+    void sync() { commitAll(true); }
+
+    // 비동기 모드 통계 (동기 모드에서는 0)
+    std::uint64_t droppedCount() const { return async ? async->dropped.load(std::memory_order_relaxed) : 0; }
+    std::uint64_t overwrittenCount() const { return async ? async->overwritten.load(std::memory_order_relaxed) : 0; }
+
+    // 비동기 모드 백그라운드 스레드가 실제로 사용하는 I/O 방식 (동기 모드는 Write)
+    IoBackend ioBackend() const { return async ? async->io.backend() : IoBackend::Write; }
+
+    // writeLog/writeLogf 호출 시간과 커밋 시간을 히스토그램에 기록 (기본 꺼짐: 켜면 호출마다 시계를 두 번 읽음)
+    // 레코드/바이트/커밋/fdatasync 카운터는 항상 집계
+    void setMetricsEnabled(bool enabled) { metricsState->enabled.store(enabled, std::memory_order_relaxed); }
+
+    // 지표 스냅샷. 기록 중인 스레드를 멈추지 않고 카운터/히스토그램을 잠금 없이 읽음 (open/close만 잠시 대기)
+    LogMetrics metrics() {
+        std::shared_lock<std::shared_mutex> table(tableMutex);
+        LogMetrics m;
+        const LogFileMetrics& closed = metricsState->closed;
+        m.records = closed.records;
+        m.bytes = closed.bytes;
+        m.commits = closed.commits;
+        m.syncs = closed.syncs;
+        m.failures = closed.failures;
+        for (const Slot& slot : slots) {
+            if (!slot.file) continue;
+            LogFileMetrics file;
+            file.name = slot.file->name;
+            slot.file->counters.read(file);
+            m.records += file.records;
+            m.bytes += file.bytes;
+            m.commits += file.commits;
+            m.syncs += file.syncs;
+            m.failures += file.failures;
+            m.files.push_back(std::move(file));
+        }
+        if (async) {
+            m.queueDepth = async->queue.size();
+            m.queueHighWater = async->highWater.load(std::memory_order_relaxed);
+            m.dropped = async->dropped.load(std::memory_order_relaxed);
+            m.overwritten = async->overwritten.load(std::memory_order_relaxed);
+        }
+        m.writeLatency = metricsState->writes.snapshot();
+        m.commitLatency = metricsState->commits.snapshot();
+        return m;
+    }
+
+    ~LogFileManager() { stopAsync(); }
+};
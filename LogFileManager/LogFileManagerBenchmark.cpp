@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LogFileManager.h"
+
+// LogFileManager 성능 측정용 벤치마크
+// - N개 스레드가 M개 파일에 번갈아 writeLog (동기/비동기 모드 x flush 정책 x 메시지 크기 조합마다 한 번)
+// - 처리량은 첫 기록부터 flushAll이 끝날 때까지, 지연 시간은 metrics()의 writeLog 호출 시간 히스토그램
+// - 결과는 JSON으로 stdout에 출력 -> 릴리스 간 비교용
+//
+// 사용법: LogFileManagerBenchmark [--threads=N] [--files=M] [--records=R(스레드당)] [--sizes=64,256,...]
+//                                 [--policies=default,batched,durable] [--modes=sync,async] [--dir=경로] [--quick]
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+struct Config {
+    std::string mode;    // sync / async
+    std::string policy;  // default / batched / durable
+    size_t threads = 4;
+    size_t files = 4;
+    size_t messageBytes = 128;
+    std::uint64_t records = 200000;  // 스레드당
+};
+
+struct Result {
+    Config config;
+    double seconds = 0;
+    LogMetrics metrics;
+
+    std::uint64_t totalRecords() const { return config.records * config.threads; }
+    double recordsPerSecond() const { return (double)totalRecords() / seconds; }
+    double megabytesPerSecond() const { return (double)metrics.bytes / seconds / 1e6; }
+};
+
+std::vector<std::string> splitList(const char* value) {
+    std::vector<std::string> items;
+    std::string current;
+    for (const char* p = value; ; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!current.empty()) items.push_back(current);
+            current.clear();
+            if (*p == '\0') break;
+        } else {
+            current += *p;
+        }
+    }
+    return items;
+}
+
+bool makePolicy(const std::string& name, FlushPolicy& policy) {
+    if (name == "default") policy = FlushPolicy();
+    else if (name == "batched") policy = FlushPolicy::batched(256);
+    else if (name == "durable") policy = FlushPolicy::durable();
+    else return false;
+    return true;
+}
+
+Result runOnce(const Config& config, const std::filesystem::path& dir) {
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    FlushPolicy policy;
+    makePolicy(config.policy, policy);
+
+    Result result;
+    result.config = config;
+    {
+        LogFileManager manager = config.mode == "async" ? LogFileManager(AsyncOptions{}) : LogFileManager();
+        manager.setMetricsEnabled(true);
+        std::vector<LogHandle> handles;
+        for (size_t i = 0; i < config.files; ++i) {
+            handles.push_back(manager.openLogFile((dir / ("bench" + std::to_string(i) + ".log")).string(), policy));
+        }
+        const std::string message(config.messageBytes, 'x');
+
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < config.threads; ++t) {
+            threads.emplace_back([&, t] {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (std::uint64_t i = 0; i < config.records; ++i) {
+                    manager.writeLog(handles[(t + i) % handles.size()], message);
+                }
+            });
+        }
+        while (ready.load() != config.threads) std::this_thread::yield();
+        const auto start = bench_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& thread : threads) thread.join();
+        manager.flushAll();
+        result.seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+        result.metrics = manager.metrics();
+    }
+    std::filesystem::remove_all(dir);
+    return result;
+}
+
+void printLatency(const char* name, const LatencySnapshot& latency, const char* suffix) {
+    std::printf("\"%s\": {\"count\": %llu, \"mean\": %.1f, \"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}%s",
+                name, (unsigned long long)latency.count(), latency.mean(), (unsigned long long)latency.percentile(50),
+                (unsigned long long)latency.percentile(99), (unsigned long long)latency.percentile(99.9),
+                (unsigned long long)latency.max(), suffix);
+}
+
+void printJson(const std::vector<Result>& results) {
+    std::printf("{\n  \"benchmark\": \"LogFileManager\",\n  \"hardware_threads\": %u,\n  \"results\": [\n",
+                std::thread::hardware_concurrency());
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        const LogMetrics& m = r.metrics;
+        std::printf("    {\"mode\": \"%s\", \"policy\": \"%s\", \"threads\": %zu, \"files\": %zu, \"message_bytes\": %zu, "
+                    "\"records\": %llu, \"seconds\": %.6f, \"records_per_sec\": %.0f, \"mb_per_sec\": %.3f, "
+                    "\"commits\": %llu, \"syncs\": %llu, \"dropped\": %llu, \"queue_high_water\": %zu, ",
+                    r.config.mode.c_str(), r.config.policy.c_str(), r.config.threads, r.config.files,
+                    r.config.messageBytes, (unsigned long long)r.totalRecords(), r.seconds, r.recordsPerSecond(),
+                    r.megabytesPerSecond(), (unsigned long long)m.commits, (unsigned long long)m.syncs,
+                    (unsigned long long)m.dropped, m.queueHighWater);
+        printLatency("write_latency_ns", m.writeLatency, ", ");
+        printLatency("commit_latency_ns", m.commitLatency, "");
+        std::printf("}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+bool parseSize(const char* arg, const char* key, size_t& out) {
+    const size_t length = std::strlen(key);
+    if (std::strncmp(arg, key, length) != 0) return false;
+    out = (size_t)std::strtoull(arg + length, nullptr, 10);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config base;
+    std::vector<std::string> modes{"sync", "async"};
+    std::vector<std::string> policies{"default", "batched"};
+    std::vector<size_t> sizes{64, 512};
+    std::filesystem::path dir = "bench_logs";
+    bool recordsGiven = false;
+    bool quick = false;
+    bool ok = true;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        size_t value = 0;
+        if (parseSize(arg, "--threads=", base.threads)) continue;
+        if (parseSize(arg, "--files=", base.files)) continue;
+        if (parseSize(arg, "--records=", value)) {
+            base.records = value;
+            recordsGiven = true;
+        } else if (std::strncmp(arg, "--sizes=", 8) == 0) {
+            sizes.clear();
+            for (const std::string& item : splitList(arg + 8)) sizes.push_back((size_t)std::strtoull(item.c_str(), nullptr, 10));
+        } else if (std::strncmp(arg, "--policies=", 11) == 0) {
+            policies = splitList(arg + 11);
+        } else if (std::strncmp(arg, "--modes=", 8) == 0) {
+            modes = splitList(arg + 8);
+        } else if (std::strncmp(arg, "--dir=", 6) == 0) {
+            dir = arg + 6;
+        } else if (std::strcmp(arg, "--quick") == 0) {
+            quick = true;
+        } else {
+            ok = false;
+        }
+    }
+    FlushPolicy unused;
+    for (const std::string& policy : policies) ok = ok && makePolicy(policy, unused);
+    for (const std::string& mode : modes) ok = ok && (mode == "sync" || mode == "async");
+    if (!ok || base.threads == 0 || base.files == 0 || sizes.empty() || policies.empty() || modes.empty()) {
+        std::cerr << "사용법: " << argv[0]
+                  << " [--threads=N] [--files=M] [--records=R] [--sizes=64,256] [--policies=default,batched,durable]"
+                     " [--modes=sync,async] [--dir=경로] [--quick]"
+                  << std::endl;
+        return 1;
+    }
+    if (quick && !recordsGiven) base.records = 20000;
+
+    std::vector<Result> results;
+    try {
+        for (const std::string& mode : modes) {
+            for (const std::string& policy : policies) {
+                for (size_t size : sizes) {
+                    Config config = base;
+                    config.mode = mode;
+                    config.policy = policy;
+                    config.messageBytes = size;
+                    // fdatasync가 매 줄 일어나므로 연산 수를 줄임
+                    if (policy == "durable" && !recordsGiven) config.records = std::max<std::uint64_t>(100, base.records / 100);
+                    results.push_back(runOnce(config, dir));
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "오류: " << e.what() << std::endl;
+        return 1;
+    }
+    printJson(results);
+    return 0;
+}
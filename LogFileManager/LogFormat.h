@@ -0,0 +1,182 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// writeLogf 형식 문자열: "{}" 자리마다 인자 하나, 중괄호 자체는 "{{" / "}}"
+// 예) m.writeLogf(handle, "user={} latency={}ms ok={}", name, 12.5, true);
+// 지원 인자: 정수, 실수(std::to_chars 최단 표현), bool, char, 문자열(const char*, std::string, std::string_view)
+namespace log_file_manager_detail {
+
+    template <typename>
+    inline constexpr bool unsupportedArg = false;
+
+    // 인자를 저장/출력 형태로 정규화 (문자열류는 모두 string_view)
+    template <typename T>
+    constexpr auto toLogArg(const T& value) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return value;
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return std::string_view(value);
+        } else {
+            static_assert(unsupportedArg<T>, "writeLogf가 지원하지 않는 인자 타입입니다");
+        }
+    }
+
+    template <typename T>
+    using LogArg = decltype(toLogArg(std::declval<const T&>()));
+
+    // 형식 문자열의 "{}" 개수 (형식 오류는 -1)
+    constexpr int countPlaceholders(std::string_view format) {
+        int count = 0;
+        for (size_t i = 0; i < format.size(); ++i) {
+            if (format[i] == '{') {
+                if (i + 1 >= format.size()) return -1;
+                if (format[i + 1] == '}') count++;
+                else if (format[i + 1] != '{') return -1;  // "{:x}" 등 서식 지정은 지원하지 않음
+                ++i;
+            } else if (format[i] == '}') {
+                if (i + 1 >= format.size() || format[i + 1] != '}') return -1;
+                ++i;
+            }
+        }
+        return count;
+    }
+
+    inline void appendArg(std::string& out, bool value) { out.append(value ? "true" : "false"); }
+    inline void appendArg(std::string& out, char value) { out.push_back(value); }
+    inline void appendArg(std::string& out, std::string_view value) { out.append(value); }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void appendArg(std::string& out, T value) {
+        char buffer[32];  // 64비트 정수 / double 최단 표현 모두 이 안에 들어감
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    // format[pos]부터 다음 "{}" 직전까지의 문자열(중괄호 이스케이프 해제)을 붙이고 "{}" 다음 위치 반환
+    inline size_t appendLiteral(std::string& out, std::string_view format, size_t pos) {
+        while (pos < format.size()) {
+            const size_t brace = format.find_first_of("{}", pos);
+            if (brace == std::string_view::npos) {
+                out.append(format.substr(pos));
+                return format.size();
+            }
+            out.append(format.substr(pos, brace - pos));
+            if (format[brace] == '{' && format[brace + 1] == '}') return brace + 2;
+            out.push_back(format[brace]);  // "{{" 또는 "}}"
+            pos = brace + 2;
+        }
+        return pos;
+    }
+
+    // 검증된 형식 문자열을 out 뒤에 전개 (out의 capacity를 재사용하므로 정상 상태에서는 할당 없음)
+    template <typename... Args>
+    void formatTo(std::string& out, std::string_view format, const Args&... args) {
+        size_t pos = 0;
+        ((pos = appendLiteral(out, format, pos), appendArg(out, args)), ...);
+        appendLiteral(out, format, pos);
+    }
+
+    // --- 비동기 지연 포맷용 인자 직렬화 (큐 슬롯에 원시 값만 복사) ---
+
+    template <typename T>
+    size_t packedSize(const T&) {
+        return sizeof(T);
+    }
+    inline size_t packedSize(std::string_view value) { return sizeof(std::uint32_t) + value.size(); }
+
+    template <typename T>
+    char* pack(char* out, const T& value) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+    inline char* pack(char* out, std::string_view value) {
+        const std::uint32_t size = (std::uint32_t)value.size();
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), value.data(), value.size());
+        return out + sizeof(size) + value.size();
+    }
+
+    template <typename T>
+    const char* unpack(const char* in, T& value) {
+        std::memcpy(&value, in, sizeof(T));
+        return in + sizeof(T);
+    }
+    inline const char* unpack(const char* in, std::string_view& value) {
+        std::uint32_t size;
+        std::memcpy(&size, in, sizeof(size));
+        value = std::string_view(in + sizeof(size), size);  // 슬롯 안을 그대로 가리킴
+        return in + sizeof(size) + size;
+    }
+
+    // 슬롯 내용: [형식 문자열 포인터/길이][타임스탬프][인자...]
+    template <typename... Args>
+    size_t packedRecordSize(std::string_view timestamp, const Args&... args) {
+        return sizeof(const char*) + sizeof(size_t) + packedSize(timestamp) + (size_t(0) + ... + packedSize(args));
+    }
+
+    template <typename... Args>
+    void packRecord(char* out, std::string_view format, std::string_view timestamp, const Args&... args) {
+        out = pack(out, format.data());
+        out = pack(out, format.size());
+        out = pack(out, timestamp);
+        ((out = pack(out, args)), ...);
+    }
+
+    // 백그라운드 스레드에서 호출: 슬롯 내용을 "timestamp message\n"으로 전개해 out 뒤에 붙임
+    template <typename... Args>
+    void expandRecord(std::string_view packed, std::string& out) {
+        const char* in = packed.data();
+        const char* formatData;
+        size_t formatSize;
+        std::string_view timestamp;
+        in = unpack(in, formatData);
+        in = unpack(in, formatSize);
+        in = unpack(in, timestamp);
+        std::tuple<Args...> args;
+        std::apply([&](auto&... arg) { ((in = unpack(in, arg)), ...); }, args);
+
+        out.append(timestamp);
+        out.push_back(' ');
+        std::apply([&](const auto&... arg) { formatTo(out, std::string_view(formatData, formatSize), arg...); },
+                   args);
+        out.push_back('\n');
+    }
+
+    // 동기 포맷용 스레드별 버퍼
+    inline std::string& threadFormatBuffer() {
+        thread_local std::string buffer;
+        buffer.clear();
+        return buffer;
+    }
+
+    // 컴파일 타임에 검증되는 형식 문자열 ("{}" 개수가 인자 수와 다르거나 중괄호가 어긋나면 컴파일 오류)
+    template <typename... Args>
+    class BasicLogFormatString {
+    private:
+        std::string_view format;
+
+    public:
+        template <typename S>
+            requires std::is_convertible_v<const S&, std::string_view>
+        consteval BasicLogFormatString(const S& s) : format(s) {
+            const int count = countPlaceholders(format);
+            if (count < 0) throw "writeLogf: 잘못된 형식 문자열 ('{}'와 '{{', '}}'만 사용 가능)";
+            if (count != (int)sizeof...(Args)) throw "writeLogf: '{}' 개수와 인자 수가 다릅니다";
+        }
+
+        std::string_view view() const { return format; }
+    };
+}
+
+// 인자 타입으로 검증하는 형식 문자열 (type_identity로 추론에서 제외)
+template <typename... Args>
+using LogFormatString = log_file_manager_detail::BasicLogFormatString<std::type_identity_t<Args>...>;
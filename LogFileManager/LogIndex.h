@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AppendFile.h"
+#include "LogReader.h"
+#include "LogTimestamp.h"
+
+namespace log_file_manager_detail {
+
+    // 인덱스 항목: line번째 줄이 offset 바이트에서 시작하고 타임스탬프가 time(epoch 마이크로초)을 나타냄
+    // (기록 경로도 타임스탬프 정밀도로 내린 값을 넣으므로 다시 만든 항목과 같음)
+    struct IndexEntry {
+        std::uint64_t line = 0;
+        std::uint64_t offset = 0;
+        std::int64_t time = 0;
+    };
+
+    // 비동기 모드에서 pending에 담긴 레코드 하나의 track 인자 (잠금 구간에서 순서대로 track)
+    struct StagedRecord {
+        std::uint64_t size = 0;
+        std::uint64_t newlines = 0;
+        std::int64_t time = 0;
+    };
+
+    // 로그 파일 옆의 "<로그 파일>.idx" 사이드카 인덱스
+    // - 약 every줄마다 항목 하나 (레코드 경계 기준이므로 여러 줄 메시지가 있으면 정확히 every의 배수는 아님)
+    // - 파일 형식: 16바이트 헤더("LOGIDX1\0", every, 예약) + 24바이트 IndexEntry 배열 (호스트 바이트 순서)
+    // - 항목은 로그 내용보다 먼저 디스크에 쓰이지 않음 (커밋 시 로그 -> 인덱스 순서로 write)
+    //   비정상 종료로 뒤처지거나 맞지 않으면 열 때 마지막으로 유효한 항목부터 로그를 다시 읽어 이어서 만듦
+    class LineIndex {
+    private:
+        static constexpr char magic[8] = {'L', 'O', 'G', 'I', 'D', 'X', '1', '\0'};
+        static constexpr size_t headerSize = 16;
+
+        std::string path;
+        std::uint32_t every;
+        std::vector<IndexEntry> entries;  // LogFile::mutex 보호
+        AppendFile out;
+
+        // 기록 위치 (LogFile::mutex 보유 상태에서만 갱신: 회전의 reset과 같은 잠금으로 직렬화)
+        std::uint64_t lines = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t nextLine = 0;
+
+        // 기존 .idx에서 로그 파일과 맞는 앞부분만 읽음. 파일을 새로 써야 하면 false
+        bool load(const std::string& indexPath, std::string_view log) {
+            MappedFile file(indexPath);
+            const std::string_view data = file.view();
+            std::uint32_t storedEvery = 0;
+            if (data.size() < headerSize || std::memcmp(data.data(), magic, sizeof(magic)) != 0) return false;
+            std::memcpy(&storedEvery, data.data() + sizeof(magic), sizeof(storedEvery));
+            if (storedEvery != every) return false;
+
+            const size_t count = (data.size() - headerSize) / sizeof(IndexEntry);
+            bool intact = (data.size() - headerSize) % sizeof(IndexEntry) == 0;
+            for (size_t i = 0; i < count; ++i) {
+                IndexEntry e;
+                std::memcpy(&e, data.data() + headerSize + i * sizeof(IndexEntry), sizeof(e));
+                const bool lineStart = e.offset == 0 || (e.offset <= log.size() && log[e.offset - 1] == '\n');
+                const bool ordered = entries.empty() || (e.line > entries.back().line && e.offset > entries.back().offset);
+                if (!lineStart || e.offset >= log.size() || !ordered) {
+                    intact = false;
+                    break;
+                }
+                entries.push_back(e);
+            }
+            return intact;
+        }
+
+        void appendEntry(const IndexEntry& e) {
+            out.append(std::string_view((const char*)&e, sizeof(e)));
+        }
+
+        void appendHeader() {
+            char header[headerSize] = {};
+            std::memcpy(header, magic, sizeof(magic));
+            std::memcpy(header + sizeof(magic), &every, sizeof(every));
+            out.append(std::string_view(header, headerSize));
+        }
+
+    public:
+        LineIndex(const std::string& logPath, std::uint32_t every, TimestampZone zone)
+            : path(logPath + ".idx"), every(every) {
+            MappedFile logFile(logPath);
+            const std::string_view log = logFile.view();
+
+            const bool intact = load(path, log);
+            if (!intact) std::remove(path.c_str());  // 헤더부터 다시 씀 (유효한 앞부분은 entries에 남아 있음)
+            out.open(path);
+            if (!out.is_open()) {
+                throw std::runtime_error("인덱스 파일을 열 수 없습니다: " + path);
+            }
+            if (!intact) {
+                appendHeader();
+                for (const IndexEntry& e : entries) appendEntry(e);
+            }
+
+            // 마지막 항목 이후 부분만 다시 읽어 이어서 색인
+            size_t pos = 0;
+            if (!entries.empty()) {
+                lines = entries.back().line;
+                pos = (size_t)entries.back().offset;
+                nextLine = lines + every;
+            }
+            while (pos < log.size()) {
+                const void* newline = std::memchr(log.data() + pos, '\n', log.size() - pos);
+                const size_t next = newline ? (size_t)((const char*)newline - log.data()) + 1 : log.size();
+                IndexEntry e;
+                if (lines >= nextLine && parseTimestamp(log.substr(pos, next - pos), zone, e.time)) {
+                    e.line = lines;
+                    e.offset = pos;
+                    add(e);
+                    nextLine = lines + every;
+                }
+                if (newline) lines++;
+                pos = next;
+            }
+            bytes = log.size();
+            out.flush();
+        }
+
+        // 파일 끝에 text(레코드 하나)를 붙이기 직전에 호출. 항목을 남길 차례면 entry를 채우고 true
+        bool track(size_t size, std::uint64_t newlines, std::int64_t time, IndexEntry& entry) {
+            const bool due = lines >= nextLine;
+            if (due) {
+                entry = IndexEntry{lines, bytes, time};
+                nextLine = lines + every;
+            }
+            lines += newlines;
+            bytes += size;
+            return due;
+        }
+
+        // track이 만든 항목 등록 (LogFile::mutex 보유 상태. 디스크에는 flush에서 기록)
+        void add(const IndexEntry& e) {
+            entries.push_back(e);
+            appendEntry(e);
+        }
+
+        bool flush() { return out.flush(); }
+
+        // 디스크립터 캐시가 로그 파일과 함께 닫고 다시 엶 (LogFile::mutex 보유 상태)
+        void park() { out.close(); }
+        bool reopen() {
+            out.open(path);
+            return out.is_open();
+        }
+        AppendFile& output() { return out; }  // 배치 커밋용
+
+        // 로그 파일이 회전되어 빈 파일로 다시 시작할 때 (LogFile::mutex 보유 상태, 버퍼는 비어 있어야 함)
+        void reset() {
+            out.close();
+            std::remove(path.c_str());
+            out.open(path);
+            appendHeader();
+            entries.clear();
+            lines = bytes = nextLine = 0;
+        }
+
+        // line번째 줄 이전에서 가장 가까운 항목 (없으면 파일 처음)
+        IndexEntry findLine(std::uint64_t line) const {
+            auto it = std::upper_bound(entries.begin(), entries.end(), line,
+                                       [](std::uint64_t l, const IndexEntry& e) { return l < e.line; });
+            return it == entries.begin() ? IndexEntry{} : *(it - 1);
+        }
+
+        // time보다 먼저 기록된 마지막 항목 (없으면 파일 처음). 기록 시각이 대체로 증가한다고 가정
+        IndexEntry findTime(std::int64_t time) const {
+            auto it = std::partition_point(entries.begin(), entries.end(),
+                                           [time](const IndexEntry& e) { return e.time < time; });
+            return it == entries.begin() ? IndexEntry{} : *(it - 1);
+        }
+
+        // time 이후에 기록된 첫 항목의 위치 (없으면 UINT64_MAX). 그 앞까지만 읽으면 됨
+        std::uint64_t offsetFrom(std::int64_t time) const {
+            auto it = std::partition_point(entries.begin(), entries.end(),
+                                           [time](const IndexEntry& e) { return e.time < time; });
+            return it == entries.end() ? UINT64_MAX : it->offset;
+        }
+
+        size_t size() const { return entries.size(); }
+    };
+}
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define LOGFILEMANAGER_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "AppendFile.h"
+
+// 비동기 모드 백그라운드 스레드가 여러 파일의 버퍼를 내보내는 방식
+enum class IoBackend {
+    Auto,   // Linux: io_uring (커널/seccomp가 막으면 Write), Windows: Overlapped, 그 외: Write
+    Uring,  // 더티 파일 전체의 write(+fdatasync)를 io_uring 제출 한 번으로 (없으면 Write로 대체)
+    Write   // 파일마다 write 시스템 콜 (Windows는 Overlapped I/O로 동시에 제출)
+};
+
+namespace log_file_manager_detail {
+
+    struct IoRequest {
+        AppendFile* file;
+        bool ok = true;
+    };
+
+    // 배치 I/O. 백그라운드 스레드 전용 (io_uring 링은 스레드 사이에 공유하지 않음)
+    // flush/sync는 AppendFile::flush/sync와 같은 결과를 내되 여러 파일을 한 번에 제출
+    class IoBatch {
+    private:
+#if defined(LOGFILEMANAGER_IO_URING)
+        static constexpr unsigned ringEntries = 64;
+
+        int ring = -1;
+        void* ringMemory = nullptr;
+        size_t ringBytes = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqeBytes = 0;
+        unsigned* sqTail = nullptr;
+        unsigned* sqMask = nullptr;
+        unsigned* sqArray = nullptr;
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        unsigned* cqMask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        unsigned sqEntries = 0;
+
+        // 필요한 기능(단일 mmap, IORING_OP_WRITE가 있는 5.6 이상)이 없으면 false
+        bool setupRing() {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            ring = (int)::syscall(__NR_io_uring_setup, ringEntries, &params);
+            if (ring < 0) return false;
+            if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_RW_CUR_POS)) {
+                releaseRing();
+                return false;
+            }
+            ringBytes = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                         params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+            ringMemory = ::mmap(nullptr, ringBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring,
+                                IORING_OFF_SQ_RING);
+            sqeBytes = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqeMemory = ::mmap(nullptr, sqeBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring,
+                                     IORING_OFF_SQES);
+            if (ringMemory == MAP_FAILED || sqeMemory == MAP_FAILED) {
+                if (ringMemory == MAP_FAILED) ringMemory = nullptr;
+                if (sqeMemory != MAP_FAILED) ::munmap(sqeMemory, sqeBytes);
+                releaseRing();
+                return false;
+            }
+            char* base = (char*)ringMemory;
+            sqes = (io_uring_sqe*)sqeMemory;
+            sqTail = (unsigned*)(base + params.sq_off.tail);
+            sqMask = (unsigned*)(base + params.sq_off.ring_mask);
+            sqArray = (unsigned*)(base + params.sq_off.array);
+            cqHead = (unsigned*)(base + params.cq_off.head);
+            cqTail = (unsigned*)(base + params.cq_off.tail);
+            cqMask = (unsigned*)(base + params.cq_off.ring_mask);
+            cqes = (io_uring_cqe*)(base + params.cq_off.cqes);
+            sqEntries = params.sq_entries;
+            return true;
+        }
+
+        void releaseRing() {
+            if (sqes) ::munmap(sqes, sqeBytes);
+            if (ringMemory) ::munmap(ringMemory, ringBytes);
+            if (ring >= 0) ::close(ring);
+            sqes = nullptr;
+            ringMemory = nullptr;
+            ring = -1;
+        }
+
+        // submit이 결과를 받지 못한 요청의 results 값 (커널이 돌려주는 res는 음수 errno이므로 겹치지 않음)
+        static constexpr int notSubmitted = INT_MIN;       // 커널이 가져가지 않음 -> 일반 시스템 콜로 다시 해도 됨
+        static constexpr int unknownResult = INT_MIN + 1;  // 제출했지만 완료를 확인하지 못함 -> 다시 쓰면 중복될 수 있음
+
+        // fill(sqe, i)로 채운 SQE n개(n <= sqEntries)를 한 번에 제출하고, 모두 완료될 때까지 대기해 res를 results[i]에
+        // io_uring_enter가 실패하면 이미 커널이 가져간 SQE의 완료를 먼저 모두 받은 뒤 false (링은 더 쓰지 않음)
+        template <typename Fill>
+        bool submit(size_t n, Fill&& fill, std::vector<int>& results) {
+            unsigned tail = *sqTail;  // 제출하는 쪽은 이 스레드뿐
+            const unsigned mask = *sqMask;
+            for (size_t i = 0; i < n; ++i, ++tail) {
+                const unsigned slot = tail & mask;
+                io_uring_sqe& sqe = sqes[slot];
+                std::memset(&sqe, 0, sizeof(sqe));
+                fill(sqe, i);
+                sqe.user_data = i;
+                sqArray[slot] = slot;
+            }
+            std::atomic_ref<unsigned>(*sqTail).store(tail, std::memory_order_release);
+
+            results.assign(n, unknownResult);
+            size_t completed = 0;
+            auto reap = [&] {
+                unsigned head = std::atomic_ref<unsigned>(*cqHead).load(std::memory_order_relaxed);
+                const unsigned ready = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+                for (; head != ready; ++head, ++completed) {
+                    const io_uring_cqe& cqe = cqes[head & *cqMask];
+                    if (cqe.user_data < n) results[cqe.user_data] = cqe.res;
+                }
+                std::atomic_ref<unsigned>(*cqHead).store(head, std::memory_order_release);
+            };
+            size_t toSubmit = n;
+            while (completed < n) {
+                const long r = ::syscall(__NR_io_uring_enter, ring, (unsigned)toSubmit, 1u, IORING_ENTER_GETEVENTS,
+                                         nullptr, 0);
+                if (r < 0) {
+                    if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+                    // SQE는 순서대로 가져가므로 앞의 n - toSubmit개만 커널에 있음. 남은 것은 돌려주고 나머지 완료를 기다림
+                    const size_t inKernel = n - toSubmit;
+                    for (size_t i = inKernel; i < n; ++i) results[i] = notSubmitted;
+                    while (completed < inKernel) {
+                        const long w = ::syscall(__NR_io_uring_enter, ring, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        if (w < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) break;  // 남은 것은 unknownResult
+                        reap();
+                    }
+                    return false;
+                }
+                toSubmit -= std::min<size_t>(toSubmit, (size_t)r);
+                reap();
+            }
+            return true;
+        }
+
+        // 버퍼를 모두 내보낼 때까지 짧은 기록은 남은 부분만 다시 제출
+        void flushUring(std::vector<IoRequest>& requests) {
+            std::vector<IoRequest*> left;
+            for (IoRequest& request : requests) {
+                if (request.file->pending().empty()) continue;
+                request.file->reserve(request.file->pending().size());
+                left.push_back(&request);
+            }
+            std::vector<int> results;
+            while (!left.empty()) {
+                const size_t n = std::min<size_t>(left.size(), sqEntries);
+                const bool submitted = submit(n, [&](io_uring_sqe& sqe, size_t i) {
+                    const std::string_view data = left[i]->file->pending();
+                    sqe.opcode = IORING_OP_WRITE;
+                    sqe.fd = left[i]->file->descriptor();
+                    sqe.addr = (std::uint64_t)(uintptr_t)data.data();
+                    sqe.len = (unsigned)std::min<size_t>(data.size(), 1u << 30);
+                    sqe.off = (std::uint64_t)-1;  // 파일 위치 사용 (O_APPEND이므로 항상 끝)
+                }, results);
+                std::vector<IoRequest*> again;
+                for (size_t i = 0; i < n; ++i) {
+                    AppendFile& file = *left[i]->file;
+                    const int res = results[i];
+                    if (res == notSubmitted || res == -EINTR || res == -EAGAIN) {
+                        again.push_back(left[i]);
+                    } else if (res <= 0) {
+                        // unknownResult 포함: 기록됐는지 알 수 없으면 다시 쓰지 않음 (중복보다 유실로 보고)
+                        left[i]->ok = false;  // AppendFile::flush처럼 기록하지 못한 내용은 버림
+                        file.consume(file.pending().size());
+                    } else {
+                        file.consume((size_t)res);
+                        if (!file.pending().empty()) again.push_back(left[i]);
+                    }
+                }
+                again.insert(again.end(), left.begin() + (std::ptrdiff_t)n, left.end());
+                if (!submitted) {  // 링을 버리고 아직 기록하지 않은 부분만 write로
+                    releaseRing();
+                    for (IoRequest* request : again) request->ok = request->file->flush() && request->ok;
+                    return;
+                }
+                left.swap(again);
+            }
+        }
+
+        void syncUring(std::vector<IoRequest>& requests) {
+            std::vector<int> results;
+            for (size_t first = 0; first < requests.size(); first += sqEntries) {
+                const size_t n = std::min<size_t>(requests.size() - first, sqEntries);
+                if (ring < 0) {  // 앞 묶음에서 링을 버린 경우
+                    for (size_t i = first; i < requests.size(); ++i) requests[i].ok = requests[i].file->sync() && requests[i].ok;
+                    return;
+                }
+                const bool submitted = submit(n, [&](io_uring_sqe& sqe, size_t i) {
+                    sqe.opcode = IORING_OP_FSYNC;
+                    sqe.fd = requests[first + i].file->descriptor();
+                    sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+                }, results);
+                if (!submitted) releaseRing();
+                for (size_t i = 0; i < n; ++i) {
+                    IoRequest& request = requests[first + i];
+                    const int res = results[i];
+                    // fdatasync는 반복해도 되므로 결과를 모르는 것도 다시 수행
+                    const bool synced = res == notSubmitted || res == unknownResult ? request.file->sync() : res == 0;
+                    request.ok = synced && request.ok;
+                }
+            }
+        }
+#endif
+
+#if defined(_WIN32)
+        // 파일마다 OVERLAPPED 쓰기를 모두 걸어 둔 뒤 완료를 기다림 (오프셋 0xFFFFFFFF'FFFFFFFF = 파일 끝에 추가)
+        static void flushOverlapped(std::vector<IoRequest>& requests) {
+            struct Pending {
+                IoRequest* request;
+                HANDLE handle;
+                OVERLAPPED overlapped;
+                bool started;
+            };
+            std::vector<Pending> pending;
+            pending.reserve(requests.size());
+            for (IoRequest& request : requests) {
+                AppendFile& file = *request.file;
+                const std::string_view data = file.pending();
+                if (data.empty()) continue;
+                Pending& p = pending.emplace_back(Pending{&request, file.overlappedHandle(), {}, false});
+                if (p.handle == INVALID_HANDLE_VALUE) continue;  // 아래에서 일반 write로
+                p.overlapped.Offset = 0xFFFFFFFF;
+                p.overlapped.OffsetHigh = 0xFFFFFFFF;
+                const DWORD length = (DWORD)std::min<size_t>(data.size(), 0x40000000);
+                p.started = WriteFile(p.handle, data.data(), length, nullptr, &p.overlapped) ||
+                            GetLastError() == ERROR_IO_PENDING;
+            }
+            for (Pending& p : pending) {
+                AppendFile& file = *p.request->file;
+                DWORD written = 0;
+                if (p.started && GetOverlappedResult(p.handle, &p.overlapped, &written, TRUE)) {
+                    file.consume(written);
+                }
+                // 시작하지 못했거나 짧게 기록된 나머지
+                if (!file.pending().empty()) p.request->ok = file.flush() && p.request->ok;
+            }
+        }
+#endif
+
+    public:
+        explicit IoBatch(IoBackend backend) {
+#if defined(LOGFILEMANAGER_IO_URING)
+            if (backend != IoBackend::Write) setupRing();
+#else
+            (void)backend;
+#endif
+        }
+
+        IoBatch(const IoBatch&) = delete;
+        IoBatch& operator=(const IoBatch&) = delete;
+
+        ~IoBatch() {
+#if defined(LOGFILEMANAGER_IO_URING)
+            releaseRing();
+#endif
+        }
+
+        // 실제로 사용 중인 방식 (Uring을 요청했어도 지원하지 않으면 Write)
+        IoBackend backend() const {
+#if defined(LOGFILEMANAGER_IO_URING)
+            return ring >= 0 ? IoBackend::Uring : IoBackend::Write;
+#else
+            return IoBackend::Write;
+#endif
+        }
+
+        // 각 파일의 버퍼를 모두 기록하고 비움. 실패한 파일은 ok = false
+        void flush(std::vector<IoRequest>& requests) {
+#if defined(LOGFILEMANAGER_IO_URING)
+            if (ring >= 0 && requests.size() > 1) {
+                flushUring(requests);
+                return;
+            }
+#elif defined(_WIN32)
+            if (requests.size() > 1) {
+                flushOverlapped(requests);
+                return;
+            }
+#endif
+            for (IoRequest& request : requests) request.ok = request.file->flush() && request.ok;
+        }
+
+        // 각 파일을 fdatasync. 실패한 파일은 ok = false
+        void sync(std::vector<IoRequest>& requests) {
+#if defined(LOGFILEMANAGER_IO_URING)
+            if (ring >= 0 && requests.size() > 1) {
+                syncUring(requests);
+                return;
+            }
+#endif
+            for (IoRequest& request : requests) request.ok = request.file->sync() && request.ok;
+        }
+    };
+}
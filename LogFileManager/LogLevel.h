@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// 로그 심각도 (낮을수록 자세함)
+enum class LogLevel : std::uint8_t { Trace, Debug, Info, Warn, Error, Fatal, Off };
+
+// 컴파일 타임 최소 심각도: 이보다 낮은 LFM_* 매크로 호출은 코드가 생성되지 않고 인자도 평가되지 않음
+// (형식 문자열/인자 검사는 그대로 수행). 예) -DLOGFILEMANAGER_MIN_LEVEL=LOGFILEMANAGER_LEVEL_INFO
+#define LOGFILEMANAGER_LEVEL_TRACE 0
+#define LOGFILEMANAGER_LEVEL_DEBUG 1
+#define LOGFILEMANAGER_LEVEL_INFO 2
+#define LOGFILEMANAGER_LEVEL_WARN 3
+#define LOGFILEMANAGER_LEVEL_ERROR 4
+#define LOGFILEMANAGER_LEVEL_FATAL 5
+#define LOGFILEMANAGER_LEVEL_OFF 6
+
+#ifndef LOGFILEMANAGER_MIN_LEVEL
+#define LOGFILEMANAGER_MIN_LEVEL LOGFILEMANAGER_LEVEL_TRACE
+#endif
+
+inline constexpr LogLevel compiledMinLevel = (LogLevel)LOGFILEMANAGER_MIN_LEVEL;
+
+// 호출 위치 하나의 속도 제한/중복 억제 상태 (LFM_*_LIMITED / LFM_*_DEDUP 매크로가 정적 지역 변수로 만듦)
+// - perSecond > 0: 1초(steady_clock 기준 구간)에 perSecond개까지만 기록, 넘친 개수는 다음 구간 첫 기록 앞에 알림
+// - dedup: 인자가 직전 호출과 같으면 기록하지 않고 세었다가, 다른 인자가 오거나 1초가 지나면 "N번 반복" 알림
+// 여러 스레드가 같은 위치를 호출해도 잠금 없이 동작 (개수는 경합 시 근사치)
+class LogCallSite {
+public:
+    struct Decision {
+        bool write = true;
+        std::uint64_t repeated = 0;    // 알릴 중복 억제 개수
+        std::uint64_t suppressed = 0;  // 알릴 속도 제한 초과 개수
+    };
+
+    static constexpr std::int64_t dedupWindowMs = 1000;
+
+    constexpr LogCallSite(std::uint32_t perSecond, bool dedup) : perSecond(perSecond), dedup(dedup) {}
+
+    LogCallSite(const LogCallSite&) = delete;
+    LogCallSite& operator=(const LogCallSite&) = delete;
+
+    bool dedups() const { return dedup; }
+
+    // hash: 인자 해시 (dedup일 때만 사용)
+    Decision admit(std::uint64_t hash) {
+        Decision d;
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count();
+        if (dedup) {
+            const std::uint64_t previous = lastHash.exchange(hash, std::memory_order_relaxed);
+            if (previous == hash && now - lastEmit.load(std::memory_order_relaxed) < dedupWindowMs) {
+                repeats.fetch_add(1, std::memory_order_relaxed);
+                d.write = false;
+                return d;
+            }
+            d.repeated = repeats.exchange(0, std::memory_order_relaxed);
+            lastEmit.store(now, std::memory_order_relaxed);
+        }
+        if (perSecond != 0) {
+            const std::int64_t second = now / 1000;
+            std::int64_t current = window.load(std::memory_order_relaxed);
+            if (current != second && window.compare_exchange_strong(current, second, std::memory_order_relaxed)) {
+                count.store(0, std::memory_order_relaxed);
+                d.suppressed = suppressed.exchange(0, std::memory_order_relaxed);
+            }
+            if (count.fetch_add(1, std::memory_order_relaxed) >= perSecond) {
+                suppressed.fetch_add(1, std::memory_order_relaxed);
+                if (d.repeated != 0) repeats.fetch_add(d.repeated, std::memory_order_relaxed);  // 다음 기록 때 알림
+                return Decision{false, 0, d.suppressed};
+            }
+        }
+        return d;
+    }
+
+private:
+    const std::uint32_t perSecond;
+    const bool dedup;
+
+    std::atomic<std::int64_t> window{INT64_MIN};
+    std::atomic<std::uint32_t> count{0};
+    std::atomic<std::uint64_t> suppressed{0};
+
+    std::atomic<std::uint64_t> lastHash{0};  // 0: 아직 없음 (해시는 0이 되지 않게 만듦)
+    std::atomic<std::uint64_t> repeats{0};
+    std::atomic<std::int64_t> lastEmit{0};
+};
+
+namespace log_file_manager_detail {
+
+    // dedup 비교용 인자 해시 (FNV-1a, 정규화된 LogArg 기준)
+    inline void hashBytes(std::uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i) hash = (hash ^ p[i]) * 1099511628211ull;
+    }
+
+    template <typename... Args>
+    std::uint64_t argHash(const Args&... args) {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto add = [&](const auto& arg) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, std::string_view>) {
+                const size_t size = arg.size();
+                hashBytes(hash, &size, sizeof(size));
+                hashBytes(hash, arg.data(), arg.size());
+            } else {
+                hashBytes(hash, &arg, sizeof(arg));
+            }
+        };
+        (add(args), ...);
+        return hash | 1;
+    }
+}
+
+// 심각도별 기록 매크로: LFM_INFO(manager, "app.log" 또는 handle, "user={} ok={}", name, ok)
+// 컴파일 타임 최소 심각도 미만이면 아무 코드도 생성하지 않고, 그 이상이면 런타임 심각도(relaxed atomic 읽기 한 번)를 확인
+#define LFM_LOG(level, manager, target, ...)                                                                  \
+    do {                                                                                                     \
+        if constexpr (LogLevel::level >= compiledMinLevel) {                                                 \
+            if ((manager).isEnabled(LogLevel::level)) (manager).writeLogf((target), __VA_ARGS__);            \
+        }                                                                                                    \
+    } while (0)
+
+// 속도 제한(perSecond > 0이면 초당 perSecond개)과 중복 억제(dedup)를 켠 호출 위치
+#define LFM_LOG_SITE(level, perSecond, dedup, manager, target, ...)                                           \
+    do {                                                                                                     \
+        if constexpr (LogLevel::level >= compiledMinLevel) {                                                 \
+            if ((manager).isEnabled(LogLevel::level)) {                                                      \
+                static LogCallSite lfmCallSite((perSecond), (dedup));                                        \
+                (manager).writeLogAt(lfmCallSite, (target), __VA_ARGS__);                                    \
+            }                                                                                                \
+        }                                                                                                    \
+    } while (0)
+
+#define LFM_TRACE(manager, target, ...) LFM_LOG(Trace, manager, target, __VA_ARGS__)
+#define LFM_DEBUG(manager, target, ...) LFM_LOG(Debug, manager, target, __VA_ARGS__)
+#define LFM_INFO(manager, target, ...) LFM_LOG(Info, manager, target, __VA_ARGS__)
+#define LFM_WARN(manager, target, ...) LFM_LOG(Warn, manager, target, __VA_ARGS__)
+#define LFM_ERROR(manager, target, ...) LFM_LOG(Error, manager, target, __VA_ARGS__)
+#define LFM_FATAL(manager, target, ...) LFM_LOG(Fatal, manager, target, __VA_ARGS__)
+
+// 예) for (...) LFM_WARN_LIMITED(m, "app.log", 10, "retry {}", n);   // 초당 최대 10줄
+//     for (...) LFM_ERROR_DEDUP(m, "error.log", "db down: {}", code);  // 같은 인자 반복은 "N번 반복" 한 줄로
+#define LFM_DEBUG_LIMITED(manager, target, perSecond, ...) LFM_LOG_SITE(Debug, perSecond, false, manager, target, __VA_ARGS__)
+#define LFM_INFO_LIMITED(manager, target, perSecond, ...) LFM_LOG_SITE(Info, perSecond, false, manager, target, __VA_ARGS__)
+#define LFM_WARN_LIMITED(manager, target, perSecond, ...) LFM_LOG_SITE(Warn, perSecond, false, manager, target, __VA_ARGS__)
+#define LFM_ERROR_LIMITED(manager, target, perSecond, ...) LFM_LOG_SITE(Error, perSecond, false, manager, target, __VA_ARGS__)
+#define LFM_DEBUG_DEDUP(manager, target, ...) LFM_LOG_SITE(Debug, 0, true, manager, target, __VA_ARGS__)
+#define LFM_INFO_DEDUP(manager, target, ...) LFM_LOG_SITE(Info, 0, true, manager, target, __VA_ARGS__)
+#define LFM_WARN_DEDUP(manager, target, ...) LFM_LOG_SITE(Warn, 0, true, manager, target, __VA_ARGS__)
+#define LFM_ERROR_DEDUP(manager, target, ...) LFM_LOG_SITE(Error, 0, true, manager, target, __VA_ARGS__)
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace log_file_manager_detail {
+
+    // HDR 방식 로그-선형 버킷 (값: ns)
+    // 64ns 미만은 1ns 단위, 그 위로는 2의 거듭제곱 구간마다 32개 (상대 오차 약 3%), 약 68초에서 포화
+    inline constexpr unsigned latencySubBits = 5;
+    inline constexpr std::uint64_t latencySubCount = 1u << latencySubBits;
+    inline constexpr unsigned latencyMaxBits = 36;
+    inline constexpr size_t latencyBucketCount = (latencyMaxBits - latencySubBits + 1) * latencySubCount;
+
+    inline size_t latencyBucket(std::uint64_t ns) {
+        ns = std::min<std::uint64_t>(ns, (1ull << latencyMaxBits) - 1);
+        if (ns < 2 * latencySubCount) return (size_t)ns;
+        const unsigned shift = (unsigned)std::bit_width(ns) - 1 - latencySubBits;
+        return (size_t)((shift + 1) * latencySubCount + (ns >> shift) - latencySubCount);
+    }
+
+    // 버킷에 들어가는 가장 큰 값 (percentile 결과로 사용)
+    inline std::uint64_t latencyBucketValue(size_t bucket) {
+        if (bucket < 2 * latencySubCount) return bucket;
+        const unsigned shift = (unsigned)(bucket / latencySubCount) - 1;
+        const std::uint64_t lower = (latencySubCount + bucket % latencySubCount) << shift;
+        return lower + (1ull << shift) - 1;
+    }
+}
+
+// 지연 시간 히스토그램 스냅샷 (ns). 값은 버킷 대표값이므로 상대 오차 약 3%
+class LatencySnapshot {
+private:
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t total = 0;
+    std::uint64_t sum = 0;
+
+public:
+    LatencySnapshot() = default;
+    LatencySnapshot(std::vector<std::uint64_t> buckets, std::uint64_t sum) : buckets(std::move(buckets)), sum(sum) {
+        for (std::uint64_t n : this->buckets) total += n;
+    }
+
+    std::uint64_t count() const { return total; }
+    double mean() const { return total == 0 ? 0.0 : (double)sum / (double)total; }
+
+    // p: 0~100 (예: 99.9). 기록이 없으면 0
+    std::uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        const double clamped = std::clamp(p, 0.0, 100.0);
+        const std::uint64_t rank = std::max<std::uint64_t>(1, (std::uint64_t)std::ceil(clamped / 100.0 * (double)total));
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) return log_file_manager_detail::latencyBucketValue(i);
+        }
+        return log_file_manager_detail::latencyBucketValue(buckets.size() - 1);
+    }
+
+    std::uint64_t min() const { return percentile(0); }
+    std::uint64_t max() const { return percentile(100); }
+};
+
+// metrics()의 파일별 누적 값 (커밋 기준: 파일에 write한 레코드/바이트)
+struct LogFileMetrics {
+    std::string name;
+    std::uint64_t records = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t commits = 0;   // 버퍼를 write로 내보낸 횟수
+    std::uint64_t syncs = 0;     // fdatasync 횟수
+    std::uint64_t failures = 0;  // 실패한 커밋 (회전 rename 실패 포함)
+};
+
+// metrics() 결과. 기록 중에도 잠금 없이 읽은 값이므로 항목 사이에 약간의 시차가 있을 수 있음
+struct LogMetrics {
+    // 모든 파일 합계 (닫은 파일 포함)
+    std::uint64_t records = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t commits = 0;
+    std::uint64_t syncs = 0;
+    std::uint64_t failures = 0;
+
+    // 비동기 모드 (동기 모드에서는 0)
+    size_t queueDepth = 0;      // 지금 큐에 대기 중인 레코드 수
+    size_t queueHighWater = 0;  // 백그라운드 스레드가 깨어날 때 본 최대 대기 수
+    std::uint64_t dropped = 0;
+    std::uint64_t overwritten = 0;
+
+    // setMetricsEnabled(true)인 동안만 기록
+    LatencySnapshot writeLatency;   // writeLog/writeLogf 호출 하나 (호출자 스레드 기준)
+    LatencySnapshot commitLatency;  // 커밋 하나의 write(+fdatasync). 비동기 모드는 배치 하나
+
+    std::vector<LogFileMetrics> files;
+};
+
+namespace log_file_manager_detail {
+
+    // 여러 스레드가 기록하는 잠금 없는 히스토그램. 스레드마다 샤드 하나를 골라 relaxed fetch_add만 수행
+    // snapshot()은 기록을 멈추지 않고 샤드를 더해 복사
+    class LatencyHistogram {
+    private:
+        static constexpr unsigned shardCount = 4;
+
+        struct alignas(64) Shard {
+            std::atomic<std::uint64_t> counts[latencyBucketCount] = {};
+            std::atomic<std::uint64_t> sum{0};
+        };
+        Shard shards[shardCount];
+
+        static unsigned threadShard() {
+            static std::atomic<unsigned> next{0};
+            thread_local const unsigned shard = next.fetch_add(1, std::memory_order_relaxed) % shardCount;
+            return shard;
+        }
+
+    public:
+        void record(std::uint64_t ns) {
+            Shard& shard = shards[threadShard()];
+            shard.counts[latencyBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+            shard.sum.fetch_add(ns, std::memory_order_relaxed);
+        }
+
+        LatencySnapshot snapshot() const {
+            std::vector<std::uint64_t> buckets(latencyBucketCount, 0);
+            std::uint64_t sum = 0;
+            for (const Shard& shard : shards) {
+                for (size_t i = 0; i < latencyBucketCount; ++i) buckets[i] += shard.counts[i].load(std::memory_order_relaxed);
+                sum += shard.sum.load(std::memory_order_relaxed);
+            }
+            return LatencySnapshot(std::move(buckets), sum);
+        }
+    };
+
+    // 파일별 누적 카운터. 커밋하는 쪽(LogFile::mutex 보유)만 갱신하고 metrics()는 잠금 없이 읽음
+    struct FileCounters {
+        std::atomic<std::uint64_t> records{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> commits{0};
+        std::atomic<std::uint64_t> syncs{0};
+        std::atomic<std::uint64_t> failures{0};
+
+        // 갱신하는 쪽이 하나이므로 read-modify-write 대신 load + store
+        static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        void read(LogFileMetrics& out) const {
+            out.records = records.load(std::memory_order_relaxed);
+            out.bytes = bytes.load(std::memory_order_relaxed);
+            out.commits = commits.load(std::memory_order_relaxed);
+            out.syncs = syncs.load(std::memory_order_relaxed);
+            out.failures = failures.load(std::memory_order_relaxed);
+        }
+    };
+
+    // 관리자 하나의 지표 상태. LogFile/백그라운드 스레드가 주소를 잡고 있으므로 unique_ptr로 고정
+    struct MetricsState {
+        std::atomic<bool> enabled{false};  // 지연 시간 측정 (시계를 읽으므로 켠 경우만)
+        LatencyHistogram writes;
+        LatencyHistogram commits;
+        LogFileMetrics closed;  // 닫은 파일의 누적 값 (tableMutex 배타 잠금 보유 상태에서 갱신)
+
+        bool timing() const { return enabled.load(std::memory_order_relaxed); }
+    };
+}
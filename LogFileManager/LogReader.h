@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace log_file_manager_detail {
+
+    // 읽기 전용 파일 매핑. 매핑 시점의 파일 크기까지만 보임 (이후 추가된 내용은 다시 매핑해야 함)
+    // 쓰기 쪽 AppendFile과 파일 디스크립터/위치를 공유하지 않으므로 기록을 방해하지 않음
+    class MappedFile {
+    private:
+        const char* base = nullptr;
+        size_t length = 0;
+        bool opened = false;
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#endif
+
+        void release() {
+#if defined(_WIN32)
+            if (base) UnmapViewOfFile(base);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+            mapping = nullptr;
+#else
+            if (base) ::munmap(const_cast<char*>(base), length);
+#endif
+            base = nullptr;
+            length = 0;
+            opened = false;
+        }
+
+    public:
+        MappedFile() = default;
+
+        explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+            file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size)) {
+                release();
+                return;
+            }
+            opened = true;
+            length = (size_t)size.QuadPart;
+            if (length == 0) return;  // 빈 파일은 매핑할 수 없음
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) base = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, length);
+            if (!base) release();
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return;
+            struct stat st;
+            if (::fstat(fd, &st) == 0) {
+                opened = true;
+                length = (size_t)st.st_size;
+                if (length != 0) {
+                    void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (p == MAP_FAILED) {
+                        opened = false;
+                        length = 0;
+                    } else {
+                        base = (const char*)p;
+                        ::madvise(p, length, MADV_SEQUENTIAL);  // 앞에서부터 읽으므로 미리 읽기 확대
+                    }
+                }
+            }
+            ::close(fd);  // 매핑은 fd를 닫아도 유지됨
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : base(std::exchange(other.base, nullptr)),
+              length(std::exchange(other.length, 0)),
+              opened(std::exchange(other.opened, false))
+#if defined(_WIN32)
+              ,
+              file(std::exchange(other.file, INVALID_HANDLE_VALUE)),
+              mapping(std::exchange(other.mapping, nullptr))
+#endif
+        {
+        }
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                release();
+                base = std::exchange(other.base, nullptr);
+                length = std::exchange(other.length, 0);
+                opened = std::exchange(other.opened, false);
+#if defined(_WIN32)
+                file = std::exchange(other.file, INVALID_HANDLE_VALUE);
+                mapping = std::exchange(other.mapping, nullptr);
+#endif
+            }
+            return *this;
+        }
+
+        ~MappedFile() { release(); }
+
+        bool is_open() const { return opened; }
+        std::string_view view() const { return base ? std::string_view(base, length) : std::string_view(); }
+    };
+
+    // data의 마지막 n줄이 시작하는 위치 (파일 끝의 '\n'은 빈 줄로 세지 않음)
+    inline size_t tailOffset(std::string_view data, size_t n) {
+        if (n == 0) return data.size();
+        size_t end = data.size();
+        if (end != 0 && data[end - 1] == '\n') end--;
+        for (size_t lines = 1;; ++lines) {
+            const size_t newline = end == 0 ? std::string_view::npos : data.rfind('\n', end - 1);
+            if (newline == std::string_view::npos) return 0;
+            if (lines == n) return newline + 1;
+            end = newline;
+        }
+    }
+}
+
+// 매핑된 로그 파일의 줄 단위 lazy range (줄마다 할당 없이 std::string_view를 돌려줌)
+// string_view는 LogLines 객체가 살아 있는 동안만 유효. 줄 끝의 '\n'은 포함하지 않음
+class LogLines {
+private:
+    log_file_manager_detail::MappedFile file;
+    std::string_view data;  // 파일 전체
+    size_t start = 0;       // 순회 시작 바이트 위치
+
+public:
+    class iterator {
+    private:
+        const char* base = nullptr;
+        const char* pos = nullptr;   // 현재 줄 시작
+        const char* last = nullptr;  // 파일 끝
+        const char* next = nullptr;  // 다음 줄 시작
+
+        void scan() {
+            if (pos == last) {
+                next = last;
+                return;
+            }
+            const void* newline = std::memchr(pos, '\n', (size_t)(last - pos));
+            next = newline ? (const char*)newline + 1 : last;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(const char* base, const char* pos, const char* last) : base(base), pos(pos), last(last) { scan(); }
+
+        std::string_view operator*() const {
+            const size_t n = (size_t)(next - pos);
+            return std::string_view(pos, n != 0 && pos[n - 1] == '\n' ? n - 1 : n);
+        }
+
+        iterator& operator++() {
+            pos = next;
+            scan();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const { return pos == other.pos; }
+
+        // 현재 줄의 파일 내 시작 위치 (readLogs(name, offset, n) / LogLines(path, offset)에 다시 넘길 수 있음)
+        std::uint64_t offset() const { return (std::uint64_t)(pos - base); }
+    };
+
+    // offset: 시작 바이트 위치 (줄의 시작이어야 함. 파일 크기 이상이면 빈 범위)
+    explicit LogLines(const std::string& path, std::uint64_t offset = 0) : file(path) {
+        if (!file.is_open()) {
+            throw std::runtime_error("파일을 열 수 없습니다: " + path);
+        }
+        data = file.view();
+        start = offset < data.size() ? (size_t)offset : data.size();
+    }
+
+    iterator begin() const { return iterator(data.data(), data.data() + start, data.data() + data.size()); }
+    iterator end() const {
+        return iterator(data.data(), data.data() + data.size(), data.data() + data.size());
+    }
+
+    // 매핑 시점의 파일 크기
+    std::uint64_t size() const { return data.size(); }
+};
+
+// readLogs(name, offset, maxLines) 결과: 다음 페이지는 nextOffset부터
+struct LogPage {
+    std::vector<std::string> lines;
+    std::uint64_t nextOffset = 0;
+    bool end = true;  // 파일 끝까지 읽음
+};
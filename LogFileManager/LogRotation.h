@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(LOGFILEMANAGER_WITH_ZLIB)
+#include <zlib.h>
+#endif
+
+#include "LogReader.h"
+#include "LogTimestamp.h"
+
+// 로그 파일 회전 정책 (0/false는 사용 안 함)
+// 회전된 세그먼트는 "<파일명>.<번호>" (번호가 클수록 최근), 압축되면 "<파일명>.<번호>.gz"
+struct RotationPolicy {
+    std::uint64_t maxBytes = 0;  // 활성 파일이 이 크기 이상이 되면 회전
+    bool daily = false;          // 날짜(타임스탬프 시간대 기준)가 바뀌면 회전
+    size_t maxFiles = 0;         // 보관할 회전 세그먼트 수 (초과분은 오래된 것부터 삭제)
+    bool compress = false;       // 회전된 세그먼트를 백그라운드에서 gzip 압축 (LOGFILEMANAGER_WITH_ZLIB 필요)
+
+    bool enabled() const { return maxBytes != 0 || daily; }
+};
+
+namespace log_file_manager_detail {
+
+    struct Segment {
+        std::uint64_t seq;
+        std::string path;
+        bool compressed;
+    };
+
+    // base의 회전 세그먼트 목록 (오래된 것부터). 압축 중이라 원본과 .gz가 함께 있으면 원본을 사용
+    inline std::vector<Segment> listSegments(const std::string& base) {
+        namespace fs = std::filesystem;
+        const fs::path basePath(base);
+        const fs::path dir = basePath.has_parent_path() ? basePath.parent_path() : fs::path(".");
+        const std::string prefix = basePath.filename().string() + ".";
+
+        std::vector<Segment> segments;
+        std::error_code ec;
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            const std::string name = it->path().filename().string();
+            if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+            std::string_view rest = std::string_view(name).substr(prefix.size());
+            const bool compressed = rest.size() > 3 && rest.substr(rest.size() - 3) == ".gz";
+            if (compressed) rest.remove_suffix(3);
+            if (rest.empty() || rest.size() > 19 || rest.find_first_not_of("0123456789") != std::string_view::npos)
+                continue;  // .idx, .tmp 등
+            segments.push_back(Segment{std::stoull(std::string(rest)), (dir / name).string(), compressed});
+        }
+        std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) {
+            return a.seq != b.seq ? a.seq < b.seq : !a.compressed && b.compressed;
+        });
+        segments.erase(std::unique(segments.begin(), segments.end(),
+                                   [](const Segment& a, const Segment& b) { return a.seq == b.seq; }),
+                       segments.end());
+        return segments;
+    }
+
+    // 날짜 번호 (회전 기준). zone이 Local이면 로컬 자정 기준
+    inline std::int64_t dayNumber(std::chrono::system_clock::time_point time, TimestampZone zone) {
+        std::int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+        if (zone == TimestampZone::Local) seconds += localUtcOffset(seconds);
+        return seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400;
+    }
+
+    // 세그먼트의 줄마다 callback(std::string_view) 호출 (.gz는 zlib으로 풀면서 읽음)
+    template <typename Callback>
+    void readSegment(const Segment& segment, Callback& callback) {
+        if (!segment.compressed) {
+            MappedFile file(segment.path);
+            if (file.is_open()) {
+                const std::string_view data = file.view();
+                for (size_t pos = 0; pos < data.size();) {
+                    size_t newline = data.find('\n', pos);
+                    if (newline == std::string_view::npos) newline = data.size();
+                    callback(data.substr(pos, newline - pos));
+                    pos = newline + 1;
+                }
+                return;
+            }
+            // 목록을 만든 뒤 압축이 끝나 원본이 지워진 경우
+            readSegment(Segment{segment.seq, segment.path + ".gz", true}, callback);
+            return;
+        }
+#if defined(LOGFILEMANAGER_WITH_ZLIB)
+        gzFile in = gzopen(segment.path.c_str(), "rb");
+        if (!in) {
+            std::error_code ec;
+            if (!std::filesystem::exists(segment.path, ec) && !ec) return;  // 목록을 만든 뒤 보관 개수 초과로 삭제된 경우
+            throw std::runtime_error("파일을 열 수 없습니다: " + segment.path);
+        }
+        gzbuffer(in, 128 * 1024);
+        std::string buffer;
+        char chunk[64 * 1024];
+        int n;
+        while ((n = gzread(in, chunk, sizeof(chunk))) > 0) {
+            buffer.append(chunk, (size_t)n);
+            size_t pos = 0;
+            for (size_t newline; (newline = buffer.find('\n', pos)) != std::string::npos; pos = newline + 1) {
+                callback(std::string_view(buffer).substr(pos, newline - pos));
+            }
+            buffer.erase(0, pos);
+        }
+        gzclose(in);
+        if (!buffer.empty()) callback(std::string_view(buffer));
+#else
+        std::error_code ec;
+        if (!std::filesystem::exists(segment.path, ec) && !ec) return;  // 목록을 만든 뒤 보관 개수 초과로 삭제된 경우
+        throw std::runtime_error("압축된 세그먼트를 읽으려면 LOGFILEMANAGER_WITH_ZLIB로 빌드해야 합니다: " + segment.path);
+#endif
+    }
+
+    // 회전된 세그먼트 후처리(압축, 오래된 세그먼트 삭제)를 맡는 백그라운드 스레드
+    // 기록 경로에서는 rename/open만 수행하고 나머지는 모두 여기서 처리하므로 writeLog가 기다리지 않음
+    class RotationWorker {
+    private:
+        struct Task {
+            std::string segment;  // 방금 회전된 세그먼트
+            std::string base;     // 활성 파일 경로
+            RotationPolicy policy;
+        };
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Task> tasks;
+        bool stopping = false;
+        std::thread worker;
+
+#if defined(LOGFILEMANAGER_WITH_ZLIB)
+        // 임시 파일에 압축한 뒤 rename으로 교체 (읽는 쪽은 원본 또는 완성된 .gz만 보게 됨)
+        static void compress(const std::string& path) {
+            MappedFile file(path);
+            if (!file.is_open()) return;
+            const std::string target = path + ".gz";
+            const std::string temp = target + ".tmp";
+            gzFile out = gzopen(temp.c_str(), "wb6");
+            if (!out) return;
+            const std::string_view data = file.view();
+            bool ok = true;
+            for (size_t pos = 0; ok && pos < data.size(); pos += 1 << 20) {
+                const unsigned n = (unsigned)std::min<size_t>(1 << 20, data.size() - pos);
+                ok = gzwrite(out, data.data() + pos, n) == (int)n;
+            }
+            ok = gzclose(out) == Z_OK && ok;
+            std::error_code ec;
+            if (ok) std::filesystem::rename(temp, target, ec);
+            if (!ok || ec) {
+                std::filesystem::remove(temp, ec);
+                return;
+            }
+            std::filesystem::remove(path, ec);
+        }
+#endif
+
+        static void prune(const std::string& base, size_t maxFiles) {
+            if (maxFiles == 0) return;
+            const std::vector<Segment> segments = listSegments(base);
+            std::error_code ec;
+            for (size_t i = 0; i + maxFiles < segments.size(); ++i) {
+                const std::string& path = segments[i].path;
+                const std::string plain = segments[i].compressed ? path.substr(0, path.size() - 3) : path;
+                std::filesystem::remove(plain, ec);
+                std::filesystem::remove(plain + ".gz", ec);
+            }
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                ready.wait(lock, [&] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;  // stopping: 남은 작업을 모두 마친 뒤 종료
+                Task task = std::move(tasks.front());
+                tasks.pop_front();
+                lock.unlock();
+#if defined(LOGFILEMANAGER_WITH_ZLIB)
+                if (task.policy.compress) compress(task.segment);
+#endif
+                prune(task.base, task.policy.maxFiles);
+                lock.lock();
+            }
+        }
+
+    public:
+        RotationWorker() : worker([this] { run(); }) {}
+
+        RotationWorker(const RotationWorker&) = delete;
+        RotationWorker& operator=(const RotationWorker&) = delete;
+
+        ~RotationWorker() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_one();
+            worker.join();
+        }
+
+        void submit(std::string segment, std::string base, const RotationPolicy& policy) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.push_back(Task{std::move(segment), std::move(base), policy});
+            }
+            ready.notify_one();
+        }
+    };
+}
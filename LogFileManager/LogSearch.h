@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LOGFILEMANAGER_SEARCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "LogReader.h"
+#include "LogTimestamp.h"
+
+// search(name, pattern, options) 옵션
+struct SearchOptions {
+    // 타임스탬프가 [from, to)인 줄만 (인덱스가 있으면 범위 밖 구간은 읽지 않음)
+    std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min();
+    std::chrono::system_clock::time_point to = std::chrono::system_clock::time_point::max();
+    size_t maxResults = 0;          // 0: 제한 없음 (파일 앞쪽부터 maxResults개)
+    size_t chunkBytes = 4 << 20;    // 작업 스레드 하나가 한 번에 맡는 크기 (줄 경계로 맞춤)
+
+    bool timed() const {
+        return from != std::chrono::system_clock::time_point::min() || to != std::chrono::system_clock::time_point::max();
+    }
+};
+
+// search 결과 한 줄 (offset: 줄의 파일 내 시작 위치, readLogs(name, offset, n)에 다시 넘길 수 있음)
+struct LogMatch {
+    std::uint64_t offset = 0;
+    std::string line;
+};
+
+namespace log_file_manager_detail {
+
+    // text에서 pattern이 처음 나오는 위치 (없으면 npos)
+    // SSE2: 16개 시작 위치의 첫 바이트/마지막 바이트를 한 번에 비교해 둘 다 맞는 후보만 memcmp로 확인
+    inline size_t findPattern(std::string_view text, std::string_view pattern) {
+        const size_t m = pattern.size();
+        if (m == 0) return 0;
+        if (text.size() < m) return std::string_view::npos;
+        const char* p = text.data();
+        if (m == 1) {
+            const void* hit = std::memchr(p, pattern[0], text.size());
+            return hit ? (size_t)((const char*)hit - p) : std::string_view::npos;
+        }
+        const size_t limit = text.size() - m + 1;  // 가능한 시작 위치 [0, limit)
+        size_t i = 0;
+#if defined(LOGFILEMANAGER_SEARCH_SSE2)
+        const __m128i first = _mm_set1_epi8(pattern[0]);
+        const __m128i last = _mm_set1_epi8(pattern[m - 1]);
+        for (; i + 16 <= limit; i += 16) {
+            const __m128i a = _mm_loadu_si128((const __m128i*)(p + i));
+            const __m128i b = _mm_loadu_si128((const __m128i*)(p + i + m - 1));
+            unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+            while (mask != 0) {
+                const size_t at = i + (size_t)std::countr_zero(mask);
+                if (std::memcmp(p + at + 1, pattern.data() + 1, m - 2) == 0) return at;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        // 나머지 (SSE2가 없으면 전체): 첫 바이트를 memchr로 찾은 뒤 확인
+        while (i < limit) {
+            const void* hit = std::memchr(p + i, pattern[0], limit - i);
+            if (!hit) break;
+            const size_t at = (size_t)((const char*)hit - p);
+            if (std::memcmp(p + at + 1, pattern.data() + 1, m - 1) == 0) return at;
+            i = at + 1;
+        }
+        return std::string_view::npos;
+    }
+
+    // search 전용 스레드 풀 (처음 search할 때 만들어 재사용)
+    // run(job, consume): 모든 작업 스레드에서 job을 실행하고 호출 스레드는 consume을 실행한 뒤 job이 끝날 때까지 대기
+    // 동시에 여러 search가 호출되면 차례로 실행
+    class SearchPool {
+    private:
+        std::mutex runMutex;  // 한 번에 하나의 run
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        const std::function<void()>* job = nullptr;  // nullptr: 늦게 깨어난 스레드는 건너뜀
+        std::uint64_t generation = 0;
+        size_t active = 0;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+
+        void work() {
+            std::uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                if (!job) continue;
+                const std::function<void()>* current = job;
+                active++;
+                lock.unlock();
+                (*current)();
+                lock.lock();
+                if (--active == 0) idle.notify_all();
+            }
+        }
+
+        void finish() {
+            std::unique_lock<std::mutex> lock(mutex);
+            job = nullptr;
+            idle.wait(lock, [&] { return active == 0; });
+        }
+
+    public:
+        explicit SearchPool(unsigned threads) {
+            for (unsigned i = 0; i < std::max(1u, threads); ++i) workers.emplace_back([this] { work(); });
+        }
+
+        SearchPool(const SearchPool&) = delete;
+        SearchPool& operator=(const SearchPool&) = delete;
+
+        ~SearchPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread& worker : workers) worker.join();
+        }
+
+        size_t size() const { return workers.size(); }
+
+        template <typename Consume>
+        void run(const std::function<void()>& task, Consume&& consume) {
+            std::lock_guard<std::mutex> one(runMutex);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = &task;
+                generation++;
+            }
+            wake.notify_all();
+            struct Finish {
+                SearchPool& pool;
+                ~Finish() { pool.finish(); }  // consume이 예외로 끝나도 task를 참조하는 스레드가 남지 않게 함
+            } finishing{*this};
+            consume();
+        }
+    };
+
+    // 타임스탬프가 없는 줄(여러 줄 메시지의 일부)은 앞쪽에서 가장 가까운 타임스탬프 줄의 시각을 따름
+    inline bool lineTime(std::string_view data, size_t lineStart, TimestampZone zone, std::int64_t& time) {
+        for (;;) {
+            const size_t newline = data.find('\n', lineStart);
+            const size_t lineEnd = newline == std::string_view::npos ? data.size() : newline;
+            if (parseTimestamp(data.substr(lineStart, lineEnd - lineStart), zone, time)) return true;
+            if (lineStart == 0) return false;
+            const size_t previous = lineStart >= 2 ? data.rfind('\n', lineStart - 2) : std::string_view::npos;
+            lineStart = previous == std::string_view::npos ? 0 : previous + 1;
+        }
+    }
+
+    // data[begin, end)를 줄 경계에 맞춘 청크로 나눠 pool에서 병렬로 검색하고, 맞는 줄을 파일 순서대로
+    // callback(std::string_view line, std::uint64_t offset)에 전달. timed면 타임스탬프가 [t0, t1)인 줄만
+    // callback이 bool을 반환하면 false에서 중단. 반환값: 전달한 줄 수
+    template <typename Callback>
+    std::uint64_t searchData(SearchPool& pool, std::string_view data, size_t begin, size_t end, std::string_view pattern,
+                             bool timed, std::int64_t t0, std::int64_t t1, TimestampZone zone,
+                             const SearchOptions& options, Callback& callback) {
+        end = std::min(end, data.size());
+        if (begin >= end) return 0;
+
+        struct Chunk {
+            size_t begin;
+            size_t end;
+            std::vector<std::pair<size_t, size_t>> lines;  // (시작, 길이)
+            bool done = false;
+        };
+        std::vector<Chunk> chunks;
+        const size_t step = std::max<size_t>(options.chunkBytes, 4096);
+        for (size_t pos = begin; pos < end;) {
+            size_t next = pos + step < end ? data.find('\n', pos + step) : std::string_view::npos;
+            next = next == std::string_view::npos || next + 1 >= end ? end : next + 1;
+            chunks.push_back(Chunk{pos, next, {}, false});
+            pos = next;
+        }
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<bool> cancelled{false};
+
+        auto scan = [&](Chunk& chunk) {
+            const std::string_view text = data.substr(chunk.begin, chunk.end - chunk.begin);
+            for (size_t pos = 0; pos < text.size() && !cancelled.load(std::memory_order_relaxed);) {
+                const size_t hit = findPattern(text.substr(pos), pattern);
+                if (hit == std::string_view::npos) break;
+                const size_t at = pos + hit;
+                const size_t previous = at == 0 ? std::string_view::npos : text.rfind('\n', at - 1);
+                const size_t lineStart = previous == std::string_view::npos || previous < pos ? pos : previous + 1;
+                const size_t newline = text.find('\n', at + pattern.size());
+                const size_t lineEnd = newline == std::string_view::npos ? text.size() : newline;
+                std::int64_t time;
+                if (!timed || (lineTime(data, chunk.begin + lineStart, zone, time) && time >= t0 && time < t1)) {
+                    chunk.lines.emplace_back(chunk.begin + lineStart, lineEnd - lineStart);
+                }
+                pos = lineEnd + 1;
+            }
+        };
+
+        const std::function<void()> task = [&] {
+            for (size_t i; !cancelled.load(std::memory_order_relaxed) &&
+                           (i = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks.size();) {
+                scan(chunks[i]);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    chunks[i].done = true;
+                }
+                ready.notify_all();
+            }
+        };
+
+        std::uint64_t delivered = 0;
+        pool.run(task, [&] {
+            struct Cancel {
+                std::atomic<bool>& flag;
+                ~Cancel() { flag.store(true, std::memory_order_relaxed); }  // 중단/예외 시 남은 청크를 건너뜀
+            } cancelOnExit{cancelled};
+            for (Chunk& chunk : chunks) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [&] { return chunk.done; });
+                }
+                for (const auto& [start, length] : chunk.lines) {
+                    const std::string_view line = data.substr(start, length);
+                    delivered++;
+                    bool more = true;
+                    if constexpr (std::is_same_v<std::invoke_result_t<Callback&, std::string_view, std::uint64_t>, bool>) {
+                        more = callback(line, (std::uint64_t)start);
+                    } else {
+                        callback(line, (std::uint64_t)start);
+                    }
+                    if (!more || (options.maxResults != 0 && delivered >= options.maxResults)) {
+                        cancelled.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+                std::vector<std::pair<size_t, size_t>>().swap(chunk.lines);
+            }
+        });
+        return delivered;
+    }
+}
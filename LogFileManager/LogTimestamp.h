@@ -0,0 +1,259 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <string_view>
+
+// 타임스탬프 소수점 이하 자릿수
+enum class TimestampPrecision {
+    Seconds,       // [2026-01-28 10:00:00]
+    Milliseconds,  // [2026-01-28 10:00:00.123]
+    Microseconds   // [2026-01-28 10:00:00.123456]
+};
+
+enum class TimestampZone {
+    Local,
+    Utc
+};
+
+enum class TimestampStyle {
+    Bracketed,  // [YYYY-MM-DD HH:MM:SS] (기존 로그 형식)
+    Iso8601     // YYYY-MM-DDTHH:MM:SS+09:00 / ...Z
+};
+
+struct TimestampFormat {
+    TimestampPrecision precision = TimestampPrecision::Seconds;
+    TimestampZone zone = TimestampZone::Local;
+    TimestampStyle style = TimestampStyle::Bracketed;
+};
+
+namespace log_file_manager_detail {
+
+    // 스레드별 타임스탬프 캐시
+    // - 초가 바뀔 때만 localtime_r/gmtime_r로 "초까지"의 앞부분을 다시 만들고
+    // - 같은 초 안에서는 앞부분 복사 + 소수점 자리만 채움 (stringstream/put_time/전역 락 없음)
+    class TimestampCache {
+    private:
+        static constexpr std::size_t prefixCapacity = 32;
+        static constexpr std::size_t suffixCapacity = 8;
+
+        std::int64_t second = INT64_MIN;  // 캐시된 앞부분의 epoch 초
+        char prefix[prefixCapacity];      // "[2026-01-28 10:00:00" 또는 "2026-01-28T10:00:00"
+        std::size_t prefixLength = 0;
+        char suffix[suffixCapacity];      // "]" / "Z" / "+09:00"
+        std::size_t suffixLength = 0;
+
+        static char* put2(char* p, int v) {
+            p[0] = (char)('0' + v / 10);
+            p[1] = (char)('0' + v % 10);
+            return p + 2;
+        }
+        static char* put4(char* p, int v) {
+            p = put2(p, v / 100);
+            return put2(p, v % 100);
+        }
+
+        void regenerate(std::time_t t, const TimestampFormat& format) {
+            std::tm tm{};
+            long offset = 0;  // UTC 기준 초 단위 오프셋 (ISO 8601 로컬 표기용)
+            if (format.zone == TimestampZone::Utc) {
+#if defined(_WIN32)
+                gmtime_s(&tm, &t);
+#else
+                gmtime_r(&t, &tm);
+#endif
+            } else {
+#if defined(_WIN32)
+                localtime_s(&tm, &t);
+                std::tm copy = tm;
+                offset = (long)(_mkgmtime(&copy) - t);
+#else
+                localtime_r(&t, &tm);
+                offset = tm.tm_gmtoff;
+#endif
+            }
+
+            const bool iso = format.style == TimestampStyle::Iso8601;
+            char* p = prefix;
+            if (!iso) *p++ = '[';
+            p = put4(p, tm.tm_year + 1900);
+            *p++ = '-';
+            p = put2(p, tm.tm_mon + 1);
+            *p++ = '-';
+            p = put2(p, tm.tm_mday);
+            *p++ = iso ? 'T' : ' ';
+            p = put2(p, tm.tm_hour);
+            *p++ = ':';
+            p = put2(p, tm.tm_min);
+            *p++ = ':';
+            p = put2(p, tm.tm_sec);
+            prefixLength = (std::size_t)(p - prefix);
+
+            char* s = suffix;
+            if (!iso) {
+                *s++ = ']';
+            } else if (format.zone == TimestampZone::Utc) {
+                *s++ = 'Z';
+            } else {
+                *s++ = offset < 0 ? '-' : '+';
+                const long a = offset < 0 ? -offset : offset;
+                s = put2(s, (int)(a / 3600));
+                *s++ = ':';
+                s = put2(s, (int)(a / 60 % 60));
+            }
+            suffixLength = (std::size_t)(s - suffix);
+        }
+
+    public:
+        static constexpr std::size_t maxLength = prefixCapacity + 1 + 6 + suffixCapacity;
+
+        // out에 최대 maxLength 바이트 기록 후 길이 반환
+        std::size_t format(char* out, std::chrono::system_clock::time_point now, const TimestampFormat& fmt) {
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+            std::int64_t sec = us / 1000000;
+            std::int64_t frac = us % 1000000;
+            if (frac < 0) {  // 1970년 이전
+                frac += 1000000;
+                sec -= 1;
+            }
+            if (sec != second) {
+                regenerate((std::time_t)sec, fmt);
+                second = sec;
+            }
+
+            char* p = out;
+            std::memcpy(p, prefix, prefixLength);
+            p += prefixLength;
+            if (fmt.precision != TimestampPrecision::Seconds) {
+                const int digits = fmt.precision == TimestampPrecision::Milliseconds ? 3 : 6;
+                int v = (int)(digits == 3 ? frac / 1000 : frac);
+                *p++ = '.';
+                for (int i = digits - 1; i >= 0; --i) {
+                    p[i] = (char)('0' + v % 10);
+                    v /= 10;
+                }
+                p += digits;
+            }
+            std::memcpy(p, suffix, suffixLength);
+            p += suffixLength;
+            return (std::size_t)(p - out);
+        }
+    };
+
+    inline std::size_t formatIndex(const TimestampFormat& f) {
+        return ((std::size_t)f.style * 2 + (std::size_t)f.zone) * 3 + (std::size_t)f.precision;
+    }
+
+    // 1970-01-01부터의 일 수 (그레고리력, 시간대 없음)
+    constexpr std::int64_t daysFromCivil(int y, int m, int d) {
+        y -= m <= 2;
+        const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const int yoe = (int)(y - era * 400);
+        const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    // 로컬 시각(초, UTC처럼 계산한 값)의 UTC 오프셋. 한 시간 단위로 스레드별 캐시
+    inline long localUtcOffset(std::int64_t localSeconds) {
+        thread_local std::int64_t cachedHour = INT64_MIN;
+        thread_local long cachedOffset = 0;
+        const std::int64_t hour = localSeconds / 3600;
+        if (hour != cachedHour) {
+            const std::time_t t = (std::time_t)localSeconds;
+            std::tm tm{};
+#if defined(_WIN32)
+            localtime_s(&tm, &t);
+            std::tm copy = tm;
+            cachedOffset = (long)(_mkgmtime(&copy) - t);
+#else
+            localtime_r(&t, &tm);
+            cachedOffset = tm.tm_gmtoff;
+#endif
+            cachedHour = hour;
+        }
+        return cachedOffset;
+    }
+
+    inline bool parseNumber(const char*& p, const char* end, int digits, int& value) {
+        if (end - p < digits) return false;
+        value = 0;
+        for (int i = 0; i < digits; ++i) {
+            if (p[i] < '0' || p[i] > '9') return false;
+            value = value * 10 + (p[i] - '0');
+        }
+        p += digits;
+        return true;
+    }
+
+    inline bool expect(const char*& p, const char* end, char c) {
+        if (p == end || *p != c) return false;
+        ++p;
+        return true;
+    }
+}
+
+// 필요한 타임스탬프 최대 길이 (호출자 버퍼 크기)
+inline constexpr std::size_t timestampMaxLength = log_file_manager_detail::TimestampCache::maxLength;
+
+// 호출자 버퍼 out(최소 timestampMaxLength 바이트)에 타임스탬프를 기록하고 길이 반환 (힙 할당 없음)
+// 캐시는 스레드별 / 형식별로 따로 유지되므로 잠금 없이 여러 스레드에서 호출 가능
+inline std::size_t formatTimestamp(char* out, const TimestampFormat& format = TimestampFormat(),
+                                   std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) {
+    thread_local log_file_manager_detail::TimestampCache caches[2 * 2 * 3];
+    return caches[log_file_manager_detail::formatIndex(format)].format(out, now, format);
+}
+
+// 로그 줄 앞의 타임스탬프(formatTimestamp가 만드는 모든 형식)를 epoch 마이크로초로 변환
+// zone: [YYYY-MM-DD HH:MM:SS] 형식은 시간대 표기가 없으므로 기록할 때의 zone을 넘겨야 함 (ISO 8601은 표기를 따름)
+// 타임스탬프로 시작하지 않는 줄(여러 줄 메시지의 이어지는 줄 등)은 false
+inline bool parseTimestamp(std::string_view text, TimestampZone zone, std::int64_t& microseconds) {
+    using namespace log_file_manager_detail;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    const bool bracketed = p != end && *p == '[';
+    if (bracketed) ++p;
+
+    int year, month, day, hour, minute, second;
+    if (!parseNumber(p, end, 4, year) || !expect(p, end, '-') || !parseNumber(p, end, 2, month) ||
+        !expect(p, end, '-') || !parseNumber(p, end, 2, day)) {
+        return false;
+    }
+    if (p == end || *p != (bracketed ? ' ' : 'T')) return false;
+    ++p;
+    if (!parseNumber(p, end, 2, hour) || !expect(p, end, ':') || !parseNumber(p, end, 2, minute) ||
+        !expect(p, end, ':') || !parseNumber(p, end, 2, second)) {
+        return false;
+    }
+
+    std::int64_t fraction = 0;
+    if (p != end && *p == '.') {
+        ++p;
+        int digits = 0;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+            if (digits < 6) fraction = fraction * 10 + (*p - '0');
+        }
+        if (digits == 0) return false;
+        for (; digits < 6; ++digits) fraction *= 10;
+    }
+
+    std::int64_t seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    if (bracketed) {
+        if (!expect(p, end, ']')) return false;
+        if (zone == TimestampZone::Local) seconds -= localUtcOffset(seconds);
+    } else if (p != end && *p == 'Z') {
+        ++p;
+    } else if (p != end && (*p == '+' || *p == '-')) {
+        const int sign = *p++ == '-' ? -1 : 1;
+        int oh, om;
+        if (!parseNumber(p, end, 2, oh) || !expect(p, end, ':') || !parseNumber(p, end, 2, om)) return false;
+        seconds -= sign * (oh * 3600 + om * 60);
+    } else {
+        return false;
+    }
+    microseconds = seconds * 1000000 + fraction;
+    return true;
+}